@@ -12,6 +12,7 @@ project "ludwig"
     pchsource "src/lwpch.cpp"
 
     files { "src/**.h", "src/**.cpp" }
+    removefiles { "src/bench/**", "src/tests/test-main.cpp" }
 
     includedirs {
         "src",
@@ -23,6 +24,15 @@ project "ludwig"
         "%{Library.cgns}",
     }
 
+    filter "options:simd=avx2"
+        vectorextensions "AVX2"
+
+    filter { "options:simd=avx512", "toolset:msc*" }
+        buildoptions { "/arch:AVX512" }
+
+    filter { "options:simd=avx512", "toolset:not msc*" }
+        buildoptions { "-mavx512f" }
+
     filter "system:windows" 
         systemversion "latest" 
         defines { "LW_PLATFORM_WINDOWS" }
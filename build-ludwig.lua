@@ -3,20 +3,34 @@ workspace "ludwig"
     configurations {"Debug", "Release", "Dist"} 
     startproject "ludwig"
 
+newoption {
+    trigger     = "simd",
+    value       = "ISA",
+    description = "Vector instruction set used by the batched solver kernels",
+    allowed     = {
+        { "sse2",   "SSE2 (scalar fallback for the f64 kernels)" },
+        { "avx2",   "AVX2" },
+        { "avx512", "AVX-512" },
+    },
+    default     = "sse2",
+}
+
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}" 
 
+-- external: the CGNS install, CGNS_SDK in the environment or libs/cgns
+cgns_sdk = os.getenv("CGNS_SDK") or "libs/cgns"
+
 IncludeDirs = {}
 IncludeDirs["vk"]      = "libs/vk/include"
--- external
--- includedir["cgns"] = "%{cgns_sdk}/include"
+IncludeDirs["cgns"]    = "%{cgns_sdk}/include"
 
 LibraryDirs = {}
 LibraryDirs["vk"]      = "libs/vk/bin/" .. outputdir .. "/vk"
--- external
--- LibraryDirs["cgns"]    = "%{cgns_sdk}/lib"
+LibraryDirs["cgns"]    = "%{cgns_sdk}/lib"
 
 Library = {}
 Library["vk"]          = "%{LibraryDirs.vk}/vk" 
+Library["cgns"]        = "%{LibraryDirs.cgns}/cgns"
 
 group "Core"
     include "libs/vk/build-vk.lua"
@@ -31,18 +45,30 @@ project "ludwig"
     objdir ("build/" .. outputdir .. "/%{prj.name}")
 
     files { "src/**.h", "src/**.cpp" }
+    removefiles { "src/bench/**", "src/tests/test-main.cpp" }
 
     includedirs {
         "%{IncludeDirs.vk}",
+        "%{IncludeDirs.cgns}",
     }
     links {
         "%{Library.vk}",
+        "%{Library.cgns}",
     }
 
     defines {
 
     }
 
+    filter "options:simd=avx2"
+        vectorextensions "AVX2"
+
+    filter { "options:simd=avx512", "toolset:msc*" }
+        buildoptions { "/arch:AVX512" }
+
+    filter { "options:simd=avx512", "toolset:not msc*" }
+        buildoptions { "-mavx512f" }
+
     filter "system:windows" 
         systemversion "latest" 
         defines { "LW_PLATFORM_WINDOWS" }
@@ -63,3 +89,124 @@ project "ludwig"
         runtime "Release" 
         optimize "On" 
         symbols "Off"
+
+-- microbenchmark suite: ludwig-bench --json results.json
+-- compiles the library sources itself so allocation tracking is on in every configuration
+project "ludwig-bench" 
+    kind "ConsoleApp" 
+    language "C++" 
+    cppdialect "C++20" 
+    staticruntime "off"
+    targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+    objdir ("build/" .. outputdir .. "/%{prj.name}")
+
+    files { "src/bench/**.h", "src/bench/**.cpp", "src/ludwig/**.h", "src/ludwig/**.cpp" }
+    removefiles { "src/ludwig/temp.cpp" }
+
+    includedirs {
+        "src",
+        "src/bench",
+        "%{IncludeDirs.vk}",
+        "%{IncludeDirs.cgns}",
+    }
+    links {
+        "%{Library.vk}",
+        "%{Library.cgns}",
+    }
+
+    defines {
+        "LW_TRACK_ALLOCATIONS",
+    }
+
+    filter "options:simd=avx2"
+        vectorextensions "AVX2"
+
+    filter { "options:simd=avx512", "toolset:msc*" }
+        buildoptions { "/arch:AVX512" }
+
+    filter { "options:simd=avx512", "toolset:not msc*" }
+        buildoptions { "-mavx512f" }
+
+    filter "system:windows" 
+        systemversion "latest" 
+        defines { "LW_PLATFORM_WINDOWS" }
+
+    filter "system:linux" 
+        links { "pthread" }
+
+    filter "configurations:Debug" 
+        defines { "LW_DEBUG" }
+        runtime "Debug" 
+        symbols "On" 
+
+    filter "configurations:Release" 
+        defines { "LW_RELEASE" }
+        runtime "Release" 
+        optimize "On" 
+        symbols "On" 
+
+    filter "configurations:Dist" 
+        defines { "LW_DIST" }
+        runtime "Release" 
+        optimize "On" 
+        symbols "Off"
+
+-- self-tests: ludwig-tests, every line printed with its expected value
+-- compiles the library sources itself, like ludwig-bench, so the allocation counts are live
+project "ludwig-tests" 
+    kind "ConsoleApp" 
+    language "C++" 
+    cppdialect "C++20" 
+    staticruntime "off"
+    targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+    objdir ("build/" .. outputdir .. "/%{prj.name}")
+
+    files { "src/tests/**.h", "src/tests/test-main.cpp", "src/ludwig/**.h", "src/ludwig/**.cpp" }
+    removefiles { "src/ludwig/temp.cpp" }
+
+    includedirs {
+        "src",
+        "%{IncludeDirs.vk}",
+        "%{IncludeDirs.cgns}",
+    }
+    links {
+        "%{Library.vk}",
+        "%{Library.cgns}",
+    }
+
+    defines {
+        "LW_TRACK_ALLOCATIONS",
+    }
+
+    filter "options:simd=avx2"
+        vectorextensions "AVX2"
+
+    filter { "options:simd=avx512", "toolset:msc*" }
+        buildoptions { "/arch:AVX512" }
+
+    filter { "options:simd=avx512", "toolset:not msc*" }
+        buildoptions { "-mavx512f" }
+
+    filter "system:windows" 
+        systemversion "latest" 
+        defines { "LW_PLATFORM_WINDOWS" }
+
+    filter "system:linux" 
+        links { "pthread" }
+
+    filter "configurations:Debug" 
+        defines { "LW_DEBUG" }
+        runtime "Debug" 
+        symbols "On" 
+
+    filter "configurations:Release" 
+        defines { "LW_RELEASE" }
+        runtime "Release" 
+        optimize "On" 
+        symbols "On" 
+
+    filter "configurations:Dist" 
+        defines { "LW_DIST" }
+        runtime "Release" 
+        optimize "On" 
+        symbols "Off"
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+
+#include "ludwig/flow/flowfield.h"
+#include "ludwig/mesh/structured-mesh.h"
+#include "ludwig/solver/tdma.h"
+#include "bench-tdma.h"
+
+namespace ludwig::bench
+{
+    // Implicit momentum system of station i from station i-1, written against the
+    // velocity(i,j).x accessors only so the same kernel runs on either FlowField layout
+    template<typename Layout>
+    static void assemble_station(const BasicFlowField<Layout>& f, const WallNormalMetrics& m, f64 nu, f64 dx, u32 i, u32 jmax,
+                                 TriDiagonal<f64>& A, std::vector<f64>& rhs)
+    {
+        for (u32 j = 1; j < jmax-1; j++)
+        {
+            f64 u  = f.velocity(i-1, j).x;
+            f64 v  = f.velocity(i-1, j).y;
+            f64 r  = 1.0 / u;
+            f64 alpha = nu * r * dx;
+            f64 beta  = v * r * dx * m.d1[j];
+            A.lower[j-1] = -alpha * m.d2_lower[j];
+            A.diag[j-1]  = 1.0 + alpha * ( m.d2_lower[j] + m.d2_upper[j] );
+            A.upper[j-1] = -alpha * m.d2_upper[j];
+            rhs[j-1]     = u - beta * ( f.velocity(i-1, j+1).x - f.velocity(i-1, j-1).x );
+        }
+    }
+
+    // Implicit marching over the whole field: assemble from station i-1, solve into station i,
+    // integrate continuity for v
+    template<typename Layout>
+    static void march_field(BasicFlowField<Layout>& f, const WallNormalMetrics& m, f64 nu, f64 dx, u32 imax, u32 jmax,
+                            TriDiagonal<f64>& A, std::vector<f64>& rhs, std::vector<f64>& scratch)
+    {
+        u32 n = jmax - 2;
+        for (u32 i = 1; i < imax; i++)
+        {
+            assemble_station(f, m, nu, dx, i, jmax, A, rhs);
+            rhs[n-1] -= A.upper[n-1] * f.velocity(i, jmax-1).x;
+            solve::thomas(A.lower.data(), A.diag.data(), A.upper.data(), rhs.data(), scratch.data(), n);
+
+            for (u32 j = 1; j < jmax-1; j++)
+                f.velocity(i, j).x = rhs[j-1];
+            for (u32 j = 1; j < jmax; j++)
+            {
+                f64 dudx = 0.5 * ( f.velocity(i, j).x - f.velocity(i-1, j).x + f.velocity(i, j-1).x - f.velocity(i-1, j-1).x ) / dx;
+                f.velocity(i, j).y = f.velocity(i, j-1).y - m.dy[j-1] * dudx;
+            }
+        }
+    }
+
+    template<typename Layout>
+    static void reset_field(BasicFlowField<Layout>& f, const std::vector<f64>& y, u32 imax, u32 jmax)
+    {
+        f64 del = 0.5 * y[jmax-1];
+        for (u32 i = 0; i < imax; i++)
+        {
+            for (u32 j = 0; j < jmax; j++)
+            {
+                f.velocity(i, j).x = 0.0;
+                f.velocity(i, j).y = 0.0;
+            }
+            f.velocity(i, jmax-1).x = 1.0;
+        }
+        for (u32 j = 1; j < jmax; j++)
+            f.velocity(0, j).x = y[j] >= del ? 1.0 : std::sqrt(y[j] / del);
+    }
+
+    static void bench_flowfield(u32 imax = 2000, u32 jmax = 256, u32 iterations = 20)
+    {
+        std::cout << "========= FlowField AoS vs SoA marching ============\n"; 
+        std::cout << " imax = " << imax << ", jmax = " << jmax << "\n";
+
+        MeshSpec spec;
+        spec.x0 = 0.001;
+        spec.x1 = 0.021;
+        spec.y1 = 0.004;
+        spec.imax = imax;
+        spec.jmax = jmax;
+        StructuredMesh mesh(spec);
+        f64 nu = 1.83e-5 / 1.182;
+        f64 dx = mesh.x[1] - mesh.x[0];
+
+        TriDiagonal<f64> A(jmax - 2);
+        std::vector<f64> rhs(jmax - 2), scratch(jmax - 2);
+
+        FlowField    aos(imax, jmax);
+        FlowFieldSoA soa(imax, jmax);
+
+        f64 t_aos = time_us(iterations, [&]() {
+            reset_field(aos, mesh.y, imax, jmax);
+            march_field(aos, mesh.metrics, nu, dx, imax, jmax, A, rhs, scratch);
+        });
+        f64 t_soa = time_us(iterations, [&]() {
+            reset_field(soa, mesh.y, imax, jmax);
+            march_field(soa, mesh.metrics, nu, dx, imax, jmax, A, rhs, scratch);
+        });
+
+        f64 diff = 0.0;
+        for (u32 i = 0; i < imax; i++)
+            for (u32 j = 0; j < jmax; j++)
+                diff = std::max(diff, std::abs(aos.velocity(i, j).x - soa.velocity(i, j).x));
+
+        std::cout << std::setw(12) << "layout" << std::setw(14) << "time [us]" << "\n";
+        std::cout << std::setw(12) << "AoS" << std::setw(14) << t_aos << "\n";
+        std::cout << std::setw(12) << "SoA" << std::setw(14) << t_soa << "\n";
+        std::cout << " speedup = " << t_aos / t_soa << ", max |u_aos - u_soa| = " << diff << " (expect 0)\n";
+    }
+}
@@ -0,0 +1,97 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "bench.h"
+#include "bench-suite.h"
+#include "bench-tdma.h"
+#include "bench-solver.h"
+#include "bench-flowfield.h"
+#include "ludwig/solver/tdma-batched.h"
+
+#if defined(LW_DEBUG)
+    #define LW_BENCH_CONFIG "debug"
+#elif defined(LW_RELEASE)
+    #define LW_BENCH_CONFIG "release"
+#elif defined(LW_DIST)
+    #define LW_BENCH_CONFIG "dist"
+#else
+    #define LW_BENCH_CONFIG "unknown"
+#endif
+
+static void print_help()
+{
+    std::cout << "ludwig-bench [options]\n"
+              << "  --json <path>      write results as JSON (default bench-results.json)\n"
+              << "  --filter <text>    only run benchmarks whose name contains text\n"
+              << "  --samples <n>      samples per benchmark (default 31, the tail is a p99 from 100 up)\n"
+              << "  --quick            small grid-size sweep\n"
+              << "  --tables           also run the comparison tables (batched/partitioned TDMA,\n"
+              << "                     theta convergence, adaptive marching, AoS vs SoA)\n";
+}
+
+int main(int argc, char** argv)
+{
+    using namespace ludwig;
+
+    bench::BenchSuite suite;
+    std::string json = "bench-results.json";
+    bool quick  = false;
+    bool tables = false;
+
+    for (int k = 1; k < argc; k++)
+    {
+        if (!std::strcmp(argv[k], "--json") && k + 1 < argc)
+            json = argv[++k];
+        else if (!std::strcmp(argv[k], "--filter") && k + 1 < argc)
+            suite.filter = argv[++k];
+        else if (!std::strcmp(argv[k], "--samples") && k + 1 < argc)
+            suite.samples = std::max(1, std::atoi(argv[++k]));
+        else if (!std::strcmp(argv[k], "--quick"))
+            quick = true;
+        else if (!std::strcmp(argv[k], "--tables"))
+            tables = true;
+        else
+        {
+            print_help();
+            return 1;
+        }
+    }
+
+    std::string build = std::string(LW_BENCH_CONFIG) + ", simd width f64 = " + std::to_string(solve::detail::simd_width_f64);
+    std::cout << "ludwig benchmarks (" << build << ")\n";
+    if (!core::allocation_tracking_enabled())
+        std::cout << "allocation tracking disabled, build with LW_TRACK_ALLOCATIONS for allocation counts\n";
+
+    bench::run_suite(suite, quick);
+
+    if (tables)
+    {
+        bench::bench_tdma();
+        bench::bench_solver();
+        bench::bench_flowfield();
+    }
+
+    if (!suite.write_json(json, build))
+    {
+        std::cout << "could not write " << json << "\n";
+        return 1;
+    }
+    std::cout << "results written to " << json << "\n";
+
+    // the marching hot loops must not touch the heap once the solver is sized
+    bool allocation_free = true;
+    if (core::allocation_tracking_enabled())
+    {
+        for (const bench::BenchResult& r : suite.results())
+        {
+            bool hot = r.name == "march/implicit" || r.name == "march/theta" || r.name == "march/newton";
+            if (hot && r.allocations_per_call > 0.0)
+            {
+                std::cout << "FAILED: " << r.name << " (" << r.size << ") allocates " << r.allocations_per_call << " times per call\n";
+                allocation_free = false;
+            }
+        }
+    }
+    return allocation_free ? 0 : 2;
+}
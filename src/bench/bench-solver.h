@@ -0,0 +1,194 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "ludwig/solver/solvers.h"
+
+namespace ludwig::bench
+{
+    // Howarth's linearly retarded edge velocity, marched well upstream of separation
+    struct RetardedPlate
+    {
+        f64 nu = 1.83e-5 / 1.182;
+        f64 L  = 1.0;
+        f64 x0;
+        f64 x1;
+        u32 jmax;
+        std::vector<f64> y;
+        std::vector<f64> u0, v0; // inflow station
+
+        RetardedPlate(f64 xa = 0.01, f64 xb = 0.05, f64 ymax = 0.004, u32 nj = 200) : x0(xa), x1(xb), jmax(nj), y(nj)
+        {
+            for (u32 j = 0; j < jmax; j++)
+                y[j] = ymax * j / (jmax - 1);
+
+            // spin up from a Pohlhausen profile upstream of x0 with fine steps, so that u and v
+            // at x0 are consistent and the inflow does not pollute the order of the scheme
+            solve::BoundaryLayerSolver spinup;
+            spinup.set_scheme(solve::MarchingScheme::Theta, 1.0);
+            u0 = march(spinup, 0.5 * x0, x0, 2001, nullptr, &v0);
+        }
+
+        f64 edge(f64 x) const { return 1.0 - x / L; }
+
+        // march imax uniform stations from x0 to x1, returns the final station of u
+        std::vector<f64> march(solve::BoundaryLayerSolver& solver, u32 imax, f64* time_us = nullptr) const
+        {
+            return march(solver, x0, x1, imax, time_us, nullptr);
+        }
+
+        std::vector<f64> march(solve::BoundaryLayerSolver& solver, f64 xa, f64 xb, u32 imax, f64* time_us, std::vector<f64>* v_out) const
+        {
+            std::vector<f64> x(imax), Ue(imax);
+            for (u32 i = 0; i < imax; i++)
+            {
+                x[i]  = xa + (xb - xa) * i / (imax - 1);
+                Ue[i] = edge(x[i]);
+            }
+            Matrix<f64> u(imax, jmax, 0.0);
+            Matrix<f64> v(imax, jmax, 0.0);
+            if (u0.empty())
+            {
+                f64 del = 5.0 * xa / std::sqrt(Ue[0] * xa / nu);
+                for (u32 j = 1; j < jmax; j++)
+                {
+                    f64 eta = std::min(y[j] / del, 1.0);
+                    u(0, j) = Ue[0] * ( 2.0*eta - 2.0*eta*eta*eta + eta*eta*eta*eta );
+                }
+            }
+            else
+            {
+                for (u32 j = 0; j < jmax; j++)
+                {
+                    u(0, j) = u0[j];
+                    v(0, j) = v0[j];
+                }
+            }
+
+            solver.resize(imax, jmax);
+            auto start = std::chrono::high_resolution_clock::now();
+            solver.solve(x, y, Ue, nu, u, v);
+            auto stop  = std::chrono::high_resolution_clock::now();
+            if (time_us)
+                *time_us = std::chrono::duration<f64, std::micro>(stop - start).count();
+
+            std::vector<f64> out(jmax);
+            for (u32 j = 0; j < jmax; j++)
+                out[j] = u(imax-1, j);
+            if (v_out)
+            {
+                v_out->resize(jmax);
+                for (u32 j = 0; j < jmax; j++)
+                    (*v_out)[j] = v(imax-1, j);
+            }
+            return out;
+        }
+    };
+
+    // streamwise error at the last station against a fine theta = 0.5 reference, for
+    // theta = 0.5 (Crank-Nicolson) and theta = 1.0 (backward Euler)
+    static void bench_marching_convergence()
+    {
+        std::cout << "========= theta-scheme convergence in x ============\n"; 
+        RetardedPlate plate(0.01, 0.05, 0.012, 300);
+        solve::BoundaryLayerSolver solver;
+        solver.set_scheme(solve::MarchingScheme::Theta, 0.5);
+        std::vector<f64> ref = plate.march(solver, 4097);
+
+        for (f64 theta : {0.5, 1.0})
+        {
+            solver.set_scheme(solve::MarchingScheme::Theta, theta);
+            std::cout << " theta = " << theta << "\n";
+            std::cout << std::setw(10) << "imax" << std::setw(16) << "max |u-u_ref|" << std::setw(10) << "order" << std::setw(14) << "time [us]" << "\n";
+
+            f64 previous = 0.0;
+            for (u32 imax : {5u, 9u, 17u, 33u, 65u, 129u})
+            {
+                f64 t = 0.0;
+                std::vector<f64> u = plate.march(solver, imax, &t);
+                f64 err = 0.0;
+                for (u32 j = 0; j < plate.jmax; j++)
+                    err = std::max(err, std::abs(u[j] - ref[j]));
+
+                std::cout << std::setw(10) << imax << std::setw(16) << err;
+                if (previous > 0.0)
+                    std::cout << std::setw(10) << std::log2(previous / err);
+                else
+                    std::cout << std::setw(10) << "-";
+                std::cout << std::setw(14) << t << "\n";
+                previous = err;
+            }
+        }
+    }
+
+    // uniform stations against adaptive marching for the same final accuracy, up to just upstream
+    // of separation (x/L = 0.12) where the profile changes fastest
+    static void bench_adaptive_marching(f64 target = 1e-4, f64 x1 = 0.118)
+    {
+        std::cout << "========= uniform vs adaptive marching =============\n"; 
+        RetardedPlate plate(0.01, x1, 0.015, 300);
+        solve::BoundaryLayerSolver solver;
+        solver.set_scheme(solve::MarchingScheme::Theta, 0.5);
+        std::vector<f64> ref = plate.march(solver, 20001);
+
+        auto error = [&](const std::vector<f64>& u)
+        {
+            f64 err = 0.0;
+            for (u32 j = 0; j < plate.jmax; j++)
+                err = std::max(err, std::abs(u[j] - ref[j]));
+            return err;
+        };
+
+        std::cout << " target max |u-u_ref| = " << target << "\n";
+        std::cout << std::setw(12) << "mode" << std::setw(10) << "stations" << std::setw(10) << "solves"
+                  << std::setw(16) << "max |u-u_ref|" << std::setw(14) << "time [us]" << "\n";
+
+        u32 imax = 9;
+        f64 uniform_time = 0.0;
+        for (; imax < 20001; imax = imax + imax / 4)
+        {
+            u64 solves = solver.solves();
+            f64 err = error(plate.march(solver, imax, &uniform_time));
+            if (err <= target)
+            {
+                std::cout << std::setw(12) << "uniform" << std::setw(10) << imax << std::setw(10) << solver.solves() - solves
+                          << std::setw(16) << err << std::setw(14) << uniform_time << "\n";
+                break;
+            }
+        }
+
+        solve::AdaptiveStepping settings;
+        settings.dx_initial = 1e-4;
+        settings.dx_max     = 0.01;
+        for (f64 tol = 1e-2; tol > 1e-9; tol *= 0.5)
+        {
+            settings.tolerance = tol;
+            std::vector<f64> u = plate.u0;
+            std::vector<f64> v = plate.v0;
+            auto start = std::chrono::high_resolution_clock::now();
+            solve::MarchingStats stats = solver.solve_adaptive(plate.x0, plate.x1, [&](f64 x) { return plate.edge(x); },
+                                                               plate.nu, plate.y, u, v, settings);
+            auto stop  = std::chrono::high_resolution_clock::now();
+            f64 t   = std::chrono::duration<f64, std::micro>(stop - start).count();
+            f64 err = error(u);
+            if (err <= target)
+            {
+                std::cout << std::setw(12) << "adaptive" << std::setw(10) << stats.steps + 1 << std::setw(10) << stats.solves
+                          << std::setw(16) << err << std::setw(14) << t << "\n";
+                std::cout << " tolerance = " << tol << ", rejected steps = " << stats.rejected
+                          << ", time saved = " << 100.0 * (1.0 - t / uniform_time) << " %\n";
+                break;
+            }
+        }
+    }
+
+    static void bench_solver()
+    {
+        bench_marching_convergence();
+        bench_adaptive_marching();
+    }
+}
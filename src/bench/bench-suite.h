@@ -0,0 +1,479 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "bench-flowfield.h"
+#include "ludwig/core/expression.h"
+#include "ludwig/core/profile.h"
+#include "ludwig/core/view.h"
+#include "ludwig/flow/flowfield.h"
+#include "ludwig/io/checkpoint.h"
+#include "ludwig/mesh/structured-mesh.h"
+#include "ludwig/optimization/gradient_descent.h"
+#include "ludwig/optimization/recovery-design.h"
+#include "ludwig/solver/solvers.h"
+#include "ludwig/solver/sweep.h"
+#include "ludwig/flow/case.h"
+#include "ludwig/solver/dense.h"
+#include "ludwig/solver/tdma.h"
+#include "ludwig/solver/tdma-parallel.h"
+
+// Microbenchmarks of the suite, each swept over the grid size. bytes_touched is a model of
+// the compulsory memory traffic of one call (f64 arrays read + written), used for GB/s.
+namespace ludwig::bench
+{
+    static void make_diagonally_dominant(TriDiagonal<f64>& A, std::vector<f64>& rhs)
+    {
+        for (u32 k = 0; k < A.n; k++)
+        {
+            A.lower[k] = (k > 0)     ? -1.0 : 0.0;
+            A.upper[k] = (k < A.n-1) ? -1.0 : 0.0;
+            A.diag[k]  = 4.0;
+            rhs[k]     = 1.0 + 1e-3 * k;
+        }
+    }
+
+    // thomas on a fresh copy of the right hand side: copy 2n, forward 6n, backward 3n
+    static void suite_tdma(BenchSuite& suite, const std::vector<u32>& sizes)
+    {
+        for (u32 n : sizes)
+        {
+            TriDiagonal<f64> A(n);
+            std::vector<f64> rhs(n), d(n), scratch(n);
+            make_diagonally_dominant(A, rhs);
+
+            suite.run("tdma/thomas", n, 11ull * n * sizeof(f64), [&]() {
+                d = rhs;
+                solve::TDMA(A, d, scratch);
+            });
+
+            solve::TridiagonalWorkspace<f64> ws;
+            ws.prepare(n);
+            suite.run("tdma/auto", n, 11ull * n * sizeof(f64), [&]() {
+                d = rhs;
+                solve::tridiagonal_solve(A, d, ws);
+            });
+        }
+    }
+
+    // momentum coefficients of one station: u, v and 3 metric arrays in, 4 coefficients out
+    static void suite_assembly(BenchSuite& suite, const std::vector<u32>& sizes)
+    {
+        for (u32 jmax : sizes)
+        {
+            MeshSpec spec;
+            spec.x0 = 0.001;
+            spec.x1 = 0.021;
+            spec.y1 = 0.004;
+            spec.imax = 2;
+            spec.jmax = jmax;
+            spec.clustering = Clustering::Tanh;
+            spec.stretching = 2.5;
+            StructuredMesh mesh(spec);
+            f64 nu = 1.83e-5 / 1.182;
+            f64 dx = mesh.x[1] - mesh.x[0];
+
+            TriDiagonal<f64> A(jmax - 2);
+            std::vector<f64> rhs(jmax - 2);
+            FlowField    aos(2, jmax);
+            FlowFieldSoA soa(2, jmax);
+            reset_field(aos, mesh.y, 2, jmax);
+            reset_field(soa, mesh.y, 2, jmax);
+
+            u64 bytes = 9ull * jmax * sizeof(f64);
+            suite.run("assembly/aos", jmax, bytes, [&]() { assemble_station(aos, mesh.metrics, nu, dx, 1, jmax, A, rhs); });
+            suite.run("assembly/soa", jmax, bytes, [&]() { assemble_station(soa, mesh.metrics, nu, dx, 1, jmax, A, rhs); });
+        }
+    }
+
+    // one BoundaryLayerSolver::advance of a flat plate station: assembly, tridiagonal solve
+    // and continuity, once per solve (implicit) or for the predictor and two correctors (theta)
+    static void suite_marching(BenchSuite& suite, const std::vector<u32>& sizes)
+    {
+        for (u32 jmax : sizes)
+        {
+            f64 nu = 1.83e-5 / 1.182;
+            std::vector<f64> y = wall_distribution(0.004, jmax, Clustering::Tanh, 2.5);
+            std::vector<f64> u0(jmax), v0(jmax, 0.0), u1(jmax), v1(jmax);
+            f64 del = 5.0 * 0.01 / std::sqrt(0.01 / nu);
+            for (u32 j = 0; j < jmax; j++)
+            {
+                f64 eta = std::min(y[j] / del, 1.0);
+                u0[j] = 2.0*eta - 2.0*eta*eta*eta + eta*eta*eta*eta;
+            }
+
+            solve::BoundaryLayerSolver solver(2, jmax);
+            solver.set_mesh(y);
+            solve::Station cur{ 0.01, 1.0, u0.data(), v0.data() };
+            solve::Station next{ 0.0101, 1.0, u1.data(), v1.data() };
+
+            solver.set_scheme(solve::MarchingScheme::Implicit);
+            suite.run("march/implicit", jmax, 24ull * jmax * sizeof(f64), [&]() { solver.advance(nullptr, cur, next, nu); });
+
+            solver.set_scheme(solve::MarchingScheme::Theta, 0.5);
+            suite.run("march/theta", jmax, 3 * 24ull * jmax * sizeof(f64), [&]() { solver.advance(nullptr, cur, next, nu); });
+
+            // coupled u, v Newton passes on the block tridiagonal system, predictor plus three
+            solver.set_scheme(solve::MarchingScheme::Newton, 0.5);
+            solver.set_iteration({ 3, 0.0 });
+            suite.run("march/newton", jmax, 4 * 24ull * jmax * sizeof(f64), [&]() { solver.advance(&cur, cur, next, nu); });
+            solver.set_iteration({});
+
+            // eddy viscosity evaluation on top of the implicit step, budget 1.5x march/implicit
+            solve::EddyViscosity turbulence;
+            turbulence.model = solve::TurbulenceModel::CebeciSmith;
+            solver.set_turbulence(turbulence);
+            solver.set_scheme(solve::MarchingScheme::Implicit);
+            suite.run("march/turbulent", jmax, 32ull * jmax * sizeof(f64), [&]() { solver.advance(nullptr, cur, next, nu); });
+
+            // momentum and energy with properties of T, one batched solve
+            std::vector<f64> T0(jmax, 298.15), T1(jmax);
+            solve::ThermalBoundaryLayerSolver thermal(jmax);
+            thermal.set_mesh(y);
+            thermal.set_wall(solve::ThermalWall::Isothermal, 330.0);
+            solve::ThermalStation tcur{ 0.01, 1.0, u0.data(), v0.data(), T0.data() };
+            solve::ThermalStation tnext{ 0.0101, 1.0, u1.data(), v1.data(), T1.data() };
+            suite.run("march/thermal", jmax, 48ull * jmax * sizeof(f64), [&]() { thermal.advance(tcur, tnext, 298.15); });
+        }
+    }
+
+    // raw binary dump of the velocity planes of an imax x jmax SoA field, the I/O floor the
+    // CGNS writer is measured against
+    static void suite_io(BenchSuite& suite, const std::vector<u32>& sizes, u32 imax = 1000)
+    {
+        std::string path = ( std::filesystem::temp_directory_path() / "ludwig-bench-io.bin" ).string();
+        for (u32 jmax : sizes)
+        {
+            FlowFieldSoA f(imax, jmax);
+            u64 plane = f.velocity.x.data.size() * sizeof(f64);
+            suite.run("io/raw-write", jmax, 2 * plane, [&]() {
+                if (FILE* file = std::fopen(path.c_str(), "wb"))
+                {
+                    std::fwrite(f.velocity.x.data.data(), 1, plane, file);
+                    std::fwrite(f.velocity.y.data.data(), 1, plane, file);
+                    std::fclose(file);
+                }
+            });
+        }
+        std::filesystem::remove(path);
+    }
+
+    // binary checkpoint against the formatted text dump run() used to print, both carrying
+    // the 7 field quantities of an imax x jmax field; bytes are the in-memory field size
+    static void suite_checkpoint(BenchSuite& suite, const std::vector<u32>& sizes, u32 imax = 200)
+    {
+        std::string bin  = ( std::filesystem::temp_directory_path() / "ludwig-bench.lwck" ).string();
+        std::string text = ( std::filesystem::temp_directory_path() / "ludwig-bench.txt" ).string();
+        for (u32 jmax : sizes)
+        {
+            MeshSpec spec;
+            spec.imax = imax;
+            spec.jmax = jmax;
+            StructuredMesh mesh(spec);
+            io::MarchingState state;
+            state.Ue.assign(imax, 1.0);
+            state.del1.assign(imax, 1e-3);
+            FlowFieldSoA f(imax, jmax);
+            for (u32 i = 0; i < imax; i++)
+                for (u32 j = 0; j < jmax; j++)
+                    f.velocity(i, j) = Vec2(std::sin(1e-2 * i * j), 1e-3 * j);
+
+            u64 bytes = 7ull * imax * jmax * sizeof(f64);
+            io::CheckpointWriter writer;
+            suite.run("io/checkpoint-write", jmax, bytes, [&]() { writer.write(bin, mesh, state, f); });
+            suite.run("io/checkpoint-read", jmax, bytes, [&]() {
+                io::MappedCheckpoint map;
+                map.open(bin);
+                f64 sum = 0.0;
+                for (u32 k = io::CheckpointHeader::PositionX; k < io::CheckpointHeader::Count; k++)
+                    for (u32 i = 0; i < imax; i++)
+                    {
+                        const f64* row = map.row(k, i);
+                        for (u32 j = 0; j < jmax; j++)
+                            sum += row[j];
+                    }
+                do_not_optimize(sum);
+            });
+
+            suite.run("io/text-write", jmax, bytes, [&]() {
+                std::ofstream out(text);
+                const ScalarPlane* planes[7] = { &f.position.x, &f.position.y, &f.velocity.x, &f.velocity.y, &f.pressure, &f.density, &f.viscosity };
+                for (const ScalarPlane* p : planes)
+                    for (u32 i = 0; i < imax; i++)
+                    {
+                        for (u32 j = 0; j < jmax; j++)
+                            out << std::setw(10) << std::setprecision(8) << (*p)(i, j) << '\t';
+                        out << '\n';
+                    }
+            });
+            suite.run("io/text-read", jmax, bytes, [&]() {
+                std::ifstream in(text);
+                f64 value = 0.0, sum = 0.0;
+                while (in >> value)
+                    sum += value;
+                do_not_optimize(sum);
+            });
+        }
+        std::filesystem::remove(bin);
+        std::filesystem::remove(text);
+    }
+
+    // a fixed batch of cases on 1, 2, 4, ... threads; size is the thread count, scaling is
+    // the ratio of the single-thread median to the median at that size
+    static void suite_sweep(BenchSuite& suite, u32 cases, u32 imax)
+    {
+        std::vector<BoundaryLayerCase> batch(cases);
+        for (u32 k = 0; k < cases; k++)
+        {
+            batch[k].U0 = 0.5 + 0.1 * k;
+            batch[k].deceleration = 0.5 * ( k % 3 );
+            batch[k].imax = imax;
+            batch[k].jmax = 120;
+            batch[k].clustering = Clustering::Tanh;
+            batch[k].stretching = 2.0;
+        }
+
+        u64 bytes = (u64)cases * imax * 24ull * 120 * sizeof(f64);
+        for (u32 threads = 1; threads <= core::hardware_threads(); threads *= 2)
+        {
+            solve::SweepRunner runner(threads);
+            suite.run("sweep/cases", threads, bytes, [&]() { do_not_optimize(runner.run(batch).size()); });
+        }
+    }
+
+    // one streamwise step of nz spanwise columns (jmax = 120) on 1, 2, 4, ... threads; size
+    // is the column count, per-column cost against march/implicit shows the batching gain
+    static void suite_spanwise(BenchSuite& suite, const std::vector<u32>& columns)
+    {
+        const u32 jmax = 120;
+        f64 nu = 1.83e-5 / 1.182;
+        std::vector<f64> y = wall_distribution(0.004, jmax, Clustering::Tanh, 2.5);
+        f64 del = 5.0 * 0.01 / std::sqrt(0.01 / nu);
+
+        for (u32 nz : columns)
+        {
+            u64 plane = (u64)jmax * nz;
+            std::vector<f64> u0(plane), v0(plane, 0.0), w0(plane), u1(plane), v1(plane), w1(plane);
+            std::vector<f64> Ue0(nz, 1.0), Ue1(nz), We(nz);
+            for (u32 k = 0; k < nz; k++)
+            {
+                Ue1[k] = 1.0 - 0.01 * k / nz;
+                We[k]  = 0.5;
+            }
+            for (u32 j = 0; j < jmax; j++)
+            {
+                f64 eta = std::min(y[j] / del, 1.0);
+                for (u32 k = 0; k < nz; k++)
+                {
+                    u0[(u64)j * nz + k] = 2.0*eta - 2.0*eta*eta*eta + eta*eta*eta*eta;
+                    w0[(u64)j * nz + k] = 0.5 * u0[(u64)j * nz + k];
+                }
+            }
+
+            solve::SpanwiseStation cur{ 0.01, Ue0.data(), u0.data(), v0.data(), w0.data() };
+            solve::SpanwiseStation next{ 0.0101, Ue1.data(), u1.data(), v1.data(), w1.data() };
+            for (u32 threads = 1; threads <= core::hardware_threads(); threads *= 2)
+            {
+                solve::SpanwiseMarcher marcher(nz, jmax, threads);
+                marcher.set_mesh(y);
+                std::string name = "march/spanwise-t" + std::to_string(threads);
+                suite.run(name, nz, 40ull * plane * sizeof(f64), [&]() { marcher.advance(cur, next, We.data(), nu); });
+            }
+        }
+    }
+
+    // gradient of the RecoveryDesign cost (3 parameters, imax = 100) by one march on dual
+    // numbers against central differences, 6 marches in f64; size is jmax
+    static void suite_gradient(BenchSuite& suite, const std::vector<u32>& sizes)
+    {
+        for (u32 jmax : sizes)
+        {
+            BoundaryLayerCase c;
+            c.plate_length = 1.0;
+            c.x_start = 0.02;
+            c.x_end   = 0.1;
+            c.height  = 0.012;
+            c.imax = 100;
+            c.jmax = jmax;
+            optimize::RecoveryDesign design(c, StructuredMesh(c.mesh_spec()));
+            const std::array<f64, 3> p = { 0.06, 0.02, 1.1 };
+
+            u64 bytes = (u64)c.imax * 24ull * jmax * sizeof(f64);
+            suite.run("gradient/dual", jmax, 4 * bytes, [&]() { do_not_optimize(optimize::evaluate_gradient<3>(design, p).grad[0]); });
+            suite.run("gradient/central", jmax, 6 * bytes, [&]() {
+                f64 g = 0.0;
+                for (u32 k = 0; k < 3; k++)
+                {
+                    std::array<f64, 3> a = p, b = p;
+                    a[k] += 1e-6;
+                    b[k] -= 1e-6;
+                    g += ( design(a) - design(b) ) / 2e-6;
+                }
+                do_not_optimize(g);
+            });
+        }
+    }
+
+    // elementwise expressions on a field of 100 stations x size nodes: the vk operators, one
+    // temporary and one pass per operator, against core::lazy fused into a single pass
+    static void suite_expression(BenchSuite& suite, const std::vector<u32>& sizes)
+    {
+        const u32 stations = 100;
+        for (u32 jmax : sizes)
+        {
+            Matrix<f64> X(stations, jmax), Y(stations, jmax), Z(stations, jmax), W(stations, jmax), R(stations, jmax, 0.0);
+            for (u64 k = 0; k < X.size; k++)
+            {
+                X[k] = 1.0 + 1e-3 * k;
+                Y[k] = 2.0 - 1e-3 * k;
+                Z[k] = 0.5;
+                W[k] = 0.25 + 1e-4 * k;
+            }
+            const f64 a = 1.5, b = -0.25, c = 3.0;
+            const u64 n = X.size;
+
+            // a X + b Y - c: eager makes 4 passes over 2 inputs and 3 temporaries, fused reads 2 writes 1
+            suite.run("expr/axpby-eager", jmax, 9 * n * sizeof(f64), [&]() {
+                Matrix<f64> aX = X;
+                aX *= a;
+                Matrix<f64> bY = Y;
+                bY *= b;
+                R = aX + bY + (-c);
+                do_not_optimize(R[0]);
+            });
+            suite.run("expr/axpby-fused", jmax, 3 * n * sizeof(f64), [&]() {
+                core::assign(R, core::lazy(X) * a + core::lazy(Y) * b - c);
+                do_not_optimize(R[0]);
+            });
+
+            // X + Y + Z + W
+            suite.run("expr/sum4-eager", jmax, 9 * n * sizeof(f64), [&]() {
+                R = X + Y + Z + W;
+                do_not_optimize(R[0]);
+            });
+            suite.run("expr/sum4-fused", jmax, 5 * n * sizeof(f64), [&]() {
+                core::assign(R, core::lazy(X) + core::lazy(Y) + core::lazy(Z) + core::lazy(W));
+                do_not_optimize(R[0]);
+            });
+        }
+    }
+
+    // dense factorizations of an n x n matrix on 1 and all threads; bytes is the matrix
+    // itself, the work is O(n^3) so GB/s here is only a relative figure
+    static void suite_dense(BenchSuite& suite, const std::vector<u32>& sizes)
+    {
+        core::ThreadPool pool;
+        for (u32 n : sizes)
+        {
+            Matrix<f64> A(n, n, 0.0);
+            for (u32 i = 0; i < n; i++)
+                for (u32 j = 0; j < n; j++)
+                    A(i, j) = ( i == j ) ? 2.0 * n : 1.0 / ( 1.0 + i + j );
+
+            u64 bytes = (u64)n * n * sizeof(f64);
+            solve::LUFactorization<f64> lu;
+            solve::CholeskyFactorization<f64> ch;
+            suite.run("dense/lu-t1", n, bytes, [&]() { do_not_optimize(lu.factor(A)); });
+            suite.run("dense/lu-pool", n, bytes, [&]() { do_not_optimize(lu.factor(A, &pool)); });
+            suite.run("dense/cholesky-pool", n, bytes, [&]() { do_not_optimize(ch.factor(A, &pool)); });
+
+            std::vector<f64> b(n, 1.0);
+            suite.run("dense/lu-solve", n, bytes, [&]() { lu.solve(b); do_not_optimize(b[0]); });
+        }
+    }
+
+    // every station of a 100 x size field copied out: u(i, j) element by element, a
+    // contiguous StationView of the Matrix and the strided station of an Array3 (i fastest)
+    static void suite_view(BenchSuite& suite, const std::vector<u32>& sizes)
+    {
+        const u32 stations = 100;
+        for (u32 jmax : sizes)
+        {
+            Matrix<f64> u(stations, jmax, 1.0);
+            Array3<f64> a(stations, jmax, 1);
+            std::vector<f64> out(jmax);
+            u64 bytes = 2ull * stations * jmax * sizeof(f64);
+
+            suite.run("view/station-elementwise", jmax, bytes, [&]() {
+                for (u32 i = 0; i < stations; i++)
+                {
+                    for (u32 j = 0; j < jmax; j++)
+                        out[j] = u(i, j);
+                    do_not_optimize(out[0]);
+                }
+            });
+            suite.run("view/station-contiguous", jmax, bytes, [&]() {
+                for (u32 i = 0; i < stations; i++)
+                {
+                    core::station(u, i).copy_to(out.data());
+                    do_not_optimize(out[0]);
+                }
+            });
+            suite.run("view/station-strided", jmax, bytes, [&]() {
+                for (u32 i = 0; i < stations; i++)
+                {
+                    core::station(a, i).copy_to(out.data());
+                    do_not_optimize(out[0]);
+                }
+            });
+        }
+    }
+
+    // the implicit step with its zones and counters idle and recording. Idle should match
+    // march/implicit; recording adds a fixed ~100 ns per zone, visible only on short stations
+    static void suite_profile(BenchSuite& suite, const std::vector<u32>& sizes)
+    {
+        for (u32 jmax : sizes)
+        {
+            f64 nu = 1.83e-5 / 1.182;
+            std::vector<f64> y = wall_distribution(0.004, jmax, Clustering::Tanh, 2.5);
+            std::vector<f64> u0(jmax), v0(jmax, 0.0), u1(jmax), v1(jmax);
+            f64 del = 5.0 * 0.01 / std::sqrt(0.01 / nu);
+            for (u32 j = 0; j < jmax; j++)
+            {
+                f64 eta = std::min(y[j] / del, 1.0);
+                u0[j] = 2.0*eta - 2.0*eta*eta*eta + eta*eta*eta*eta;
+            }
+
+            solve::BoundaryLayerSolver solver(2, jmax);
+            solver.set_mesh(y);
+            solve::Station cur{ 0.01, 1.0, u0.data(), v0.data() };
+            solve::Station next{ 0.0101, 1.0, u1.data(), v1.data() };
+
+            core::profile::enable(false);
+            suite.run("profile/implicit-idle", jmax, 24ull * jmax * sizeof(f64), [&]() { solver.advance(nullptr, cur, next, nu); });
+            core::profile::enable();
+            suite.run("profile/implicit-recording", jmax, 24ull * jmax * sizeof(f64), [&]() { solver.advance(nullptr, cur, next, nu); });
+            core::profile::enable(false);
+            core::profile::reset();
+        }
+    }
+
+    static void run_suite(BenchSuite& suite, bool quick)
+    {
+        std::vector<u32> rows  = quick ? std::vector<u32>{ 64, 1024 } : std::vector<u32>{ 64, 256, 1024, 4096, 16384, 65536, 1u << 20 };
+        std::vector<u32> nodes = quick ? std::vector<u32>{ 64, 512 }  : std::vector<u32>{ 64, 128, 256, 512, 1024, 4096 };
+        std::vector<u32> io    = quick ? std::vector<u32>{ 64 }       : std::vector<u32>{ 64, 256, 1024 };
+
+        suite.print_header();
+        suite_tdma(suite, rows);
+        suite_assembly(suite, nodes);
+        suite_marching(suite, nodes);
+        suite_io(suite, io);
+        suite_checkpoint(suite, io);
+        suite_sweep(suite, quick ? 16 : 64, quick ? 200 : 1000);
+        suite_spanwise(suite, quick ? std::vector<u32>{ 64 } : std::vector<u32>{ 8, 64, 512, 4096 });
+        suite_gradient(suite, quick ? std::vector<u32>{ 64 } : std::vector<u32>{ 64, 256 });
+        suite_expression(suite, nodes);
+        suite_view(suite, nodes);
+        suite_profile(suite, nodes);
+        suite_dense(suite, quick ? std::vector<u32>{ 128, 512 } : std::vector<u32>{ 128, 256, 512, 1024, 2048 });
+    }
+}
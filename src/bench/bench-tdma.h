@@ -0,0 +1,104 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+
+#include "ludwig/solver/tdma.h"
+#include "ludwig/solver/tdma-batched.h"
+#include "ludwig/solver/tdma-parallel.h"
+
+namespace ludwig::bench
+{
+    template<typename F>
+    static f64 time_us(u32 iterations, F&& func)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (u32 it = 0; it < iterations; it++)
+            func();
+        auto stop  = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<f64, std::micro>(stop - start).count() / iterations;
+    }
+
+    // N independent systems of n rows: N calls of TDMA against one batched solve
+    static void bench_tdma_batched(u32 n = 1024, u32 N = 64, u32 iterations = 200)
+    {
+        std::cout << "========= TDMA x N vs TDMA(BatchedTriDiagonal) =====\n"; 
+        std::cout << " n = " << n << ", N = " << N << ", simd width (f64) = " << solve::detail::simd_width_f64 << "\n";
+
+        std::vector<TriDiagonal<f64>> systems(N, TriDiagonal<f64>(n));
+        std::vector<std::vector<f64>> rhs(N, std::vector<f64>(n));
+        BatchedTriDiagonal<f64> batched(n, N);
+        std::vector<f64> batched_rhs((u64)n * N);
+
+        for (u32 s = 0; s < N; s++)
+        {
+            for (u32 k = 0; k < n; k++)
+            {
+                f64 lo = (k > 0)   ? -1.0 - 1e-3 * s : 0.0;
+                f64 up = (k < n-1) ? -1.0 + 1e-3 * s : 0.0;
+                systems[s].lower[k] = batched.lower[batched.index(k, s)] = lo;
+                systems[s].diag[k]  = batched.diag[batched.index(k, s)]  = 4.0;
+                systems[s].upper[k] = batched.upper[batched.index(k, s)] = up;
+                rhs[s][k]           = batched_rhs[batched.index(k, s)]   = 1.0;
+            }
+        }
+
+        std::vector<f64> d(n), scratch(n);
+        f64 serial = time_us(iterations, [&]() {
+            for (u32 s = 0; s < N; s++)
+            {
+                d = rhs[s];
+                solve::TDMA(systems[s], d, scratch);
+            }
+        });
+
+        std::vector<f64> bd((u64)n * N), bscratch((u64)n * N);
+        f64 batch = time_us(iterations, [&]() {
+            bd = batched_rhs;
+            solve::TDMA(batched, bd, bscratch);
+        });
+
+        std::cout << std::setw(24) << "TDMA x N [us]: "        << std::setw(12) << serial << "\n";
+        std::cout << std::setw(24) << "TDMA batched [us]: "    << std::setw(12) << batch  << "\n";
+        std::cout << std::setw(24) << "speedup: "              << std::setw(12) << serial / batch << "\n";
+    }
+
+    // one tall system: serial Thomas against the partition method
+    static void bench_tdma_partitioned(u32 n = 1u << 20, u32 iterations = 20)
+    {
+        std::cout << "========= TDMA vs TDMA_partitioned =================\n"; 
+        solve::TridiagonalWorkspace<f64> ws;
+        std::cout << " n = " << n << ", threads = " << ws.threads << "\n";
+
+        TriDiagonal<f64> A(n);
+        std::vector<f64> rhs(n, 1.0);
+        for (u32 k = 0; k < n; k++)
+        {
+            A.lower[k] = (k > 0)   ? -1.0 : 0.0;
+            A.upper[k] = (k < n-1) ? -1.0 : 0.0;
+            A.diag[k]  = 4.0;
+        }
+
+        std::vector<f64> d(n);
+        f64 serial = time_us(iterations, [&]() {
+            d = rhs;
+            solve::tridiagonal_solve(A, d, ws, solve::TridiagonalMethod::Thomas);
+        });
+        f64 parallel = time_us(iterations, [&]() {
+            d = rhs;
+            solve::tridiagonal_solve(A, d, ws, solve::TridiagonalMethod::Partitioned);
+        });
+
+        std::cout << std::setw(24) << "Thomas [us]: "      << std::setw(12) << serial   << "\n";
+        std::cout << std::setw(24) << "partitioned [us]: " << std::setw(12) << parallel << "\n";
+        std::cout << std::setw(24) << "speedup: "          << std::setw(12) << serial / parallel << "\n";
+    }
+
+    static void bench_tdma()
+    {
+        bench_tdma_batched();
+        bench_tdma_partitioned();
+    }
+}
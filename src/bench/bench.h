@@ -0,0 +1,176 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "vk/vk.h"
+#include "ludwig/core/alloc-tracker.h"
+
+namespace ludwig::bench
+{
+    // keeps a result the benchmark only computes for timing from being optimized away
+    template<typename T>
+    inline void do_not_optimize(const T& value)
+    {
+        volatile T sink = value;
+        (void)sink;
+    }
+
+    struct BenchResult
+    {
+        std::string name;
+        u32 size       = 0;   // grid dimension swept (rows, jmax, nodes)
+        u32 samples    = 0;
+        u32 iterations = 0;   // calls per sample
+        f64 min_us     = 0.0; // per call
+        f64 median_us  = 0.0;
+        f64 tail_us    = 0.0; // p99 from 100 samples up, the max below (see tail_label)
+        f64 allocations_per_call = 0.0;
+        f64 allocated_bytes_per_call = 0.0;
+        u64 bytes_touched = 0; // estimated memory traffic of one call
+    };
+
+    // Times each benchmark over `samples` samples of enough calls to last at least
+    // `min_sample_us`, and reports per-call min, median and tail with the heap traffic of
+    // the calls (needs LW_TRACK_ALLOCATIONS, zero otherwise). The tail is the p99 with at
+    // least 100 samples; with fewer the 99th percentile is just the slowest sample, so it is
+    // reported as the max.
+    class BenchSuite
+    {
+    public:
+        u32 samples = 31;
+        f64 min_sample_us = 200.0;
+        std::string filter; // only run benchmarks whose name contains filter
+
+        bool selected(const std::string& name) const { return filter.empty() || name.find(filter) != std::string::npos; }
+
+        // setup() runs untimed before every call, func() is the timed work
+        template<typename Setup, typename F>
+        void run(const std::string& name, u32 size, u64 bytes_touched, Setup&& setup, F&& func)
+        {
+            if (!selected(name))
+                return;
+
+            // calibrate the calls per sample, also warms caches and lazily sized buffers
+            u32 iterations = 1;
+            for (;;)
+            {
+                f64 t = time_calls(iterations, setup, func);
+                if (t >= min_sample_us || iterations >= (1u << 24))
+                    break;
+                iterations *= t > 0.0 ? std::clamp<u32>(u32(min_sample_us / t) + 1, 2, 16) : 16;
+            }
+
+            std::vector<f64> times(samples);
+            core::AllocationStats before = core::allocation_stats();
+            for (u32 s = 0; s < samples; s++)
+                times[s] = time_calls(iterations, setup, func) / iterations;
+            core::AllocationStats after = core::allocation_stats();
+            std::sort(times.begin(), times.end());
+
+            BenchResult r;
+            r.name = name;
+            r.size = size;
+            r.samples = samples;
+            r.iterations = iterations;
+            r.min_us = times.front();
+            r.median_us = times[samples / 2];
+            r.tail_us = samples >= 100 ? times[u32(std::ceil(0.99 * samples)) - 1] : times.back();
+            f64 calls = f64(samples) * iterations;
+            r.allocations_per_call = ( after.count - before.count ) / calls;
+            r.allocated_bytes_per_call = ( after.bytes - before.bytes ) / calls;
+            r.bytes_touched = bytes_touched;
+            print(r);
+            m_results.push_back(r);
+        }
+
+        template<typename F>
+        void run(const std::string& name, u32 size, u64 bytes_touched, F&& func)
+        {
+            run(name, size, bytes_touched, NoSetup{}, func);
+        }
+
+        static const char* tail_label(u32 samples) { return samples >= 100 ? "p99" : "max"; }
+
+        void print_header() const
+        {
+            std::cout << std::left << std::setw(28) << " benchmark" << std::right << std::setw(9) << "size"
+                      << std::setw(13) << "min [us]" << std::setw(13) << "median [us]" << std::setw(13) << std::string(tail_label(samples)) + " [us]"
+                      << std::setw(10) << "GB/s" << std::setw(12) << "allocs" << "\n";
+        }
+
+        static void print(const BenchResult& r)
+        {
+            std::cout << std::left << std::setw(28) << " " + r.name << std::right << std::setw(9) << r.size
+                      << std::setw(13) << r.min_us << std::setw(13) << r.median_us << std::setw(13) << r.tail_us
+                      << std::setw(10) << bandwidth(r) << std::setw(12) << r.allocations_per_call << "\n";
+        }
+
+        // bytes touched at the median time
+        static f64 bandwidth(const BenchResult& r) { return r.median_us > 0.0 ? r.bytes_touched / ( r.median_us * 1e3 ) : 0.0; }
+
+        bool write_json(const std::string& path, const std::string& build) const
+        {
+            std::ofstream out(path);
+            if (!out)
+                return false;
+
+            out << "{\n  \"suite\": \"ludwig\",\n  \"build\": \"" << build << "\",\n";
+            out << "  \"allocation_tracking\": " << ( core::allocation_tracking_enabled() ? "true" : "false" ) << ",\n";
+            out << "  \"results\": [\n" << std::setprecision(6);
+            for (u64 k = 0; k < m_results.size(); k++)
+            {
+                const BenchResult& r = m_results[k];
+                out << "    {\"name\": \"" << r.name << "\", \"size\": " << r.size
+                    << ", \"samples\": " << r.samples << ", \"iterations\": " << r.iterations
+                    << ", \"min_us\": " << r.min_us << ", \"median_us\": " << r.median_us << ", \"" << tail_label(r.samples) << "_us\": " << r.tail_us
+                    << ", \"allocations_per_call\": " << r.allocations_per_call
+                    << ", \"allocated_bytes_per_call\": " << r.allocated_bytes_per_call
+                    << ", \"bytes_touched\": " << r.bytes_touched << ", \"bandwidth_gbs\": " << bandwidth(r) << "}"
+                    << ( k + 1 < m_results.size() ? ",\n" : "\n" );
+            }
+            out << "  ]\n}\n";
+            return true;
+        }
+
+        const std::vector<BenchResult>& results() const { return m_results; }
+
+    private:
+        struct NoSetup { void operator()() const {} };
+
+        template<typename Setup, typename F>
+        static f64 time_calls(u32 iterations, Setup& setup, F& func)
+        {
+            // without setup the whole sample is timed at once, keeping clock reads out of short calls
+            if constexpr (std::is_same_v<std::decay_t<Setup>, NoSetup>)
+            {
+                auto start = std::chrono::steady_clock::now();
+                for (u32 it = 0; it < iterations; it++)
+                    func();
+                auto stop  = std::chrono::steady_clock::now();
+                return std::chrono::duration<f64, std::micro>(stop - start).count();
+            }
+
+            f64 total = 0.0;
+            for (u32 it = 0; it < iterations; it++)
+            {
+                setup();
+                auto start = std::chrono::steady_clock::now();
+                func();
+                auto stop  = std::chrono::steady_clock::now();
+                total += std::chrono::duration<f64, std::micro>(stop - start).count();
+            }
+            return total;
+        }
+
+    private:
+        std::vector<BenchResult> m_results;
+    };
+}
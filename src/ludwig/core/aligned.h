@@ -0,0 +1,57 @@
+#pragma once
+
+#include <new>
+#include <vector>
+
+#include "vk/vk.h"
+#include "arena.h"
+
+namespace ludwig::core
+{
+    constexpr u64 cache_line = 64;
+
+    // std::vector allocator handing out Alignment-byte aligned storage, carved from an Arena
+    // when given one (deallocation is then left to the arena), from the heap otherwise
+    template<typename T, u64 Alignment = cache_line>
+    struct AlignedAllocator
+    {
+        using value_type = T;
+
+        template<typename U>
+        struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+        Arena* arena = nullptr;
+
+        AlignedAllocator() = default;
+        AlignedAllocator(Arena* a) : arena(a) {}
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>& other) : arena(other.arena) {}
+
+        T* allocate(u64 n)
+        {
+            if (arena)
+                return arena->allocate_array<T>(n, Alignment);
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* p, u64)
+        {
+            if (!arena)
+                ::operator delete(p, std::align_val_t(Alignment));
+        }
+
+        template<typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>& other) const { return arena == other.arena; }
+    };
+
+    template<typename T>
+    using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+    // number of T that fill whole cache lines for at least n elements
+    template<typename T>
+    constexpr u32 padded_size(u32 n)
+    {
+        constexpr u32 per_line = cache_line / sizeof(T);
+        return (n + per_line - 1) / per_line * per_line;
+    }
+}
@@ -0,0 +1,72 @@
+#include "alloc-tracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace ludwig::core
+{
+    static std::atomic<u64> s_allocation_count = 0;
+    static std::atomic<u64> s_allocation_bytes = 0;
+
+    AllocationStats allocation_stats()
+    {
+        return { s_allocation_count.load(std::memory_order_relaxed), s_allocation_bytes.load(std::memory_order_relaxed) };
+    }
+}
+
+#ifdef LW_TRACK_ALLOCATIONS
+
+static void record_allocation(std::size_t size)
+{
+    ludwig::core::s_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    ludwig::core::s_allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+    record_allocation(size);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    record_allocation(size);
+    std::size_t a = static_cast<std::size_t>(align);
+#ifdef LW_PLATFORM_WINDOWS
+    void* p = _aligned_malloc(size ? size : 1, a);
+#else
+    void* p = std::aligned_alloc(a, ((size ? size : 1) + a - 1) / a * a);
+#endif
+    if (p)
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+#ifdef LW_PLATFORM_WINDOWS
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept
+{
+    operator delete(p, align);
+}
+
+#endif
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "vk/vk.h"
+
+namespace ludwig::core
+{
+    struct AllocationStats
+    {
+        u64 count = 0; // calls to operator new
+        u64 bytes = 0; // bytes requested through operator new
+    };
+
+    // process-wide counters, only maintained in builds with LW_TRACK_ALLOCATIONS defined
+    // (global operator new is replaced in alloc-tracker.cpp). Otherwise always zero.
+    AllocationStats allocation_stats();
+
+    constexpr bool allocation_tracking_enabled()
+    {
+#ifdef LW_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+}
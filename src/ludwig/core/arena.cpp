@@ -0,0 +1,45 @@
+#include "arena.h"
+
+#include <new>
+
+#ifdef __linux__
+    #include <sys/mman.h>
+#endif
+
+namespace ludwig::core
+{
+    Arena::~Arena()
+    {
+        if (m_block)
+            ::operator delete(m_block, std::align_val_t(m_alignment));
+    }
+
+    void Arena::reserve(u64 bytes, Pages pages)
+    {
+        const u64 alignment = pages == Pages::Huge ? huge_page : 64;
+        const u64 capacity  = (bytes + alignment - 1) / alignment * alignment;
+
+        // the new block first, a throwing allocation leaves the old one in place
+        u8* block = static_cast<u8*>(::operator new(capacity, std::align_val_t(alignment)));
+        if (m_block)
+            ::operator delete(m_block, std::align_val_t(m_alignment));
+
+        m_block = block;
+        m_capacity = capacity;
+        m_alignment = alignment;
+        m_used = 0;
+#ifdef __linux__
+        if (pages == Pages::Huge)
+            madvise(m_block, m_capacity, MADV_HUGEPAGE);
+#endif
+    }
+
+    void* Arena::allocate(u64 bytes, u64 alignment)
+    {
+        u64 offset = (m_used + alignment - 1) / alignment * alignment;
+        if (offset + bytes > m_capacity)
+            throw std::bad_alloc();
+        m_used = offset + bytes;
+        return m_block + offset;
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "vk/vk.h"
+
+namespace ludwig::core
+{
+    constexpr u64 huge_page = 2ull << 20;
+
+    enum class Pages : u8
+    {
+        Normal = 0, // the block is cache line aligned and sized to the request
+        Huge,       // the block is rounded up to whole 2 MB pages, aligned to one and madvised for them
+    };
+
+    // Bump allocator over one block reserved up front, allocations are never freed
+    // individually: memory is handed back with rewind() to an earlier mark() or with reset().
+    // Running out of space throws std::bad_alloc. Huge pages pay off for a block that holds a
+    // whole field and the solver buffers, not for a few rows, so they are the caller's choice.
+    class Arena
+    {
+    public:
+        Arena() = default;
+        explicit Arena(u64 bytes, Pages pages = Pages::Normal) { reserve(bytes, pages); }
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        // release the current block and reserve a new one of at least `bytes`
+        void reserve(u64 bytes, Pages pages = Pages::Normal);
+
+        void* allocate(u64 bytes, u64 alignment = 64);
+
+        template<typename T>
+        T* allocate_array(u64 n, u64 alignment = 64)
+        {
+            return static_cast<T*>(allocate(n * sizeof(T), alignment));
+        }
+
+        u64 mark() const { return m_used; }
+        void rewind(u64 mark) { m_used = mark; }
+        void reset() { m_used = 0; }
+
+        u64 used() const { return m_used; }
+        u64 capacity() const { return m_capacity; }
+        u8* data() { return m_block; }
+
+    private:
+        u8* m_block = nullptr;
+        u64 m_capacity = 0;
+        u64 m_used = 0;
+        u64 m_alignment = 0;
+    };
+
+    // hands the memory of per-step temporaries back to the arena at the end of a scope
+    class ScratchScope
+    {
+    public:
+        explicit ScratchScope(Arena& arena) : m_arena(arena), m_mark(arena.mark()) {}
+        ~ScratchScope() { m_arena.rewind(m_mark); }
+
+        ScratchScope(const ScratchScope&) = delete;
+        ScratchScope& operator=(const ScratchScope&) = delete;
+
+    private:
+        Arena& m_arena;
+        u64 m_mark;
+    };
+}
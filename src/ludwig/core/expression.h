@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+
+#include "vk/vk.h"
+
+namespace ludwig::core
+{
+    // Lazy elementwise arithmetic over Matrix, Vector, Array (anything with a size and a
+    // contiguous operator[]) and std::vector. The vk operators are eager: in
+    //   Matrix<f64> r = X * a + Y * b + c;
+    // every operator allocates a result and makes its own pass over memory. Wrapped in lazy(),
+    //   assign(r, lazy(X) * a + lazy(Y) * b + c);
+    // the operators only build a small expression tree of pointers and scalars, and assign()
+    // runs the whole tree in one loop of contiguous loads the compiler can vectorise, without
+    // any temporaries. Scalars broadcast; operands of an expression must have equal sizes.
+
+    template<typename E>
+    struct is_expression : std::false_type {};
+
+    template<typename E>
+    concept Expression = is_expression<std::remove_cvref_t<E>>::value;
+
+    template<typename T>
+    concept Scalar = std::is_arithmetic_v<T>;
+
+    template<typename T>
+    struct Leaf
+    {
+        const T* data;
+        u64 n;
+
+        T operator[](u64 i) const { return data[i]; }
+        u64 size() const { return n; }
+    };
+
+    template<typename T>
+    struct Constant
+    {
+        T value;
+
+        T operator[](u64) const { return value; }
+        u64 size() const { return 0; } // broadcasts to any size
+    };
+
+    template<typename Op, typename L, typename R>
+    struct Binary
+    {
+        L l;
+        R r;
+
+        auto operator[](u64 i) const { return Op::apply(l[i], r[i]); }
+        u64 size() const { return std::max(l.size(), r.size()); }
+    };
+
+    template<typename Op, typename A>
+    struct Unary
+    {
+        A a;
+
+        auto operator[](u64 i) const { return Op::apply(a[i]); }
+        u64 size() const { return a.size(); }
+    };
+
+    template<typename T> struct is_expression<Leaf<T>> : std::true_type {};
+    template<typename T> struct is_expression<Constant<T>> : std::true_type {};
+    template<typename Op, typename L, typename R> struct is_expression<Binary<Op, L, R>> : std::true_type {};
+    template<typename Op, typename A> struct is_expression<Unary<Op, A>> : std::true_type {};
+
+    namespace op
+    {
+        struct Add      { template<typename A, typename B> static auto apply(const A& a, const B& b) { return a + b; } };
+        struct Subtract { template<typename A, typename B> static auto apply(const A& a, const B& b) { return a - b; } };
+        struct Multiply { template<typename A, typename B> static auto apply(const A& a, const B& b) { return a * b; } };
+        struct Divide   { template<typename A, typename B> static auto apply(const A& a, const B& b) { return a / b; } };
+        struct Negate   { template<typename A> static auto apply(const A& a) { return -a; } };
+    }
+
+    namespace detail
+    {
+        // vk containers expose size as a member, std::vector as a function
+        template<typename C>
+        u64 extent(const C& c)
+        {
+            if constexpr (requires { c.size(); })
+                return (u64)c.size();
+            else
+                return (u64)c.size;
+        }
+
+        template<typename E>
+        decltype(auto) operand(E&& e)
+        {
+            if constexpr (Expression<E>)
+                return std::remove_cvref_t<E>(e);
+            else
+                return Constant<std::remove_cvref_t<E>>{ e };
+        }
+
+        template<typename Op, typename L, typename R>
+        auto binary(L&& l, R&& r)
+        {
+            using A = decltype(operand(std::forward<L>(l)));
+            using B = decltype(operand(std::forward<R>(r)));
+            Binary<Op, A, B> e{ operand(std::forward<L>(l)), operand(std::forward<R>(r)) };
+            // operands of different lengths, only a scalar (size 0) broadcasts
+            assert(e.l.size() == 0 || e.r.size() == 0 || e.l.size() == e.r.size());
+            return e;
+        }
+    }
+
+    // the container as an expression leaf; it must outlive the expression
+    template<typename C>
+    auto lazy(const C& c)
+    {
+        using T = std::remove_cvref_t<decltype(c[0])>;
+        return Leaf<T>{ &c[0], detail::extent(c) };
+    }
+
+    template<typename T>
+    Leaf<T> lazy(const T* data, u64 n) { return { data, n }; }
+
+    // at least one side must be an expression, scalars fill in the other
+    template<typename L, typename R>
+        requires ( Expression<L> && ( Expression<R> || Scalar<std::remove_cvref_t<R>> ) ) || ( Scalar<std::remove_cvref_t<L>> && Expression<R> )
+    auto operator+(L&& l, R&& r) { return detail::binary<op::Add>(std::forward<L>(l), std::forward<R>(r)); }
+
+    template<typename L, typename R>
+        requires ( Expression<L> && ( Expression<R> || Scalar<std::remove_cvref_t<R>> ) ) || ( Scalar<std::remove_cvref_t<L>> && Expression<R> )
+    auto operator-(L&& l, R&& r) { return detail::binary<op::Subtract>(std::forward<L>(l), std::forward<R>(r)); }
+
+    template<typename L, typename R>
+        requires ( Expression<L> && ( Expression<R> || Scalar<std::remove_cvref_t<R>> ) ) || ( Scalar<std::remove_cvref_t<L>> && Expression<R> )
+    auto operator*(L&& l, R&& r) { return detail::binary<op::Multiply>(std::forward<L>(l), std::forward<R>(r)); }
+
+    template<typename L, typename R>
+        requires ( Expression<L> && ( Expression<R> || Scalar<std::remove_cvref_t<R>> ) ) || ( Scalar<std::remove_cvref_t<L>> && Expression<R> )
+    auto operator/(L&& l, R&& r) { return detail::binary<op::Divide>(std::forward<L>(l), std::forward<R>(r)); }
+
+    template<Expression A>
+    auto operator-(A&& a) { return Unary<op::Negate, std::remove_cvref_t<A>>{ a }; }
+
+    // dst[i] = e[i] in one pass. dst may also appear in e, every element only reads its own index.
+    template<typename C, Expression E>
+    void assign(C& dst, const E& e)
+    {
+        const u64 n = detail::extent(dst);
+        assert(e.size() == 0 || e.size() == n);
+        auto* out = &dst[0];
+        for (u64 i = 0; i < n; i++)
+            out[i] = e[i];
+    }
+
+    // dst[i] += e[i] in one pass
+    template<typename C, Expression E>
+    void add_assign(C& dst, const E& e)
+    {
+        const u64 n = detail::extent(dst);
+        assert(e.size() == 0 || e.size() == n);
+        auto* out = &dst[0];
+        for (u64 i = 0; i < n; i++)
+            out[i] += e[i];
+    }
+}
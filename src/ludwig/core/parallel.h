@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "vk/vk.h"
+#include "profile.h"
+
+namespace ludwig::core
+{
+    inline u32 hardware_threads()
+    {
+        u32 n = std::thread::hardware_concurrency();
+        return n > 0 ? n : 1;
+    }
+
+    // runs func(k) for every k in [0, count) on up to `threads` threads (the caller included)
+    // and blocks until all of them are done. Meant for coarse work items, each call spawns
+    // its workers.
+    template<typename F>
+    void parallel_for(u32 count, u32 threads, F&& func)
+    {
+        threads = std::min(threads, count);
+        if (threads <= 1)
+        {
+            for (u32 k = 0; k < count; k++)
+                func(k);
+            return;
+        }
+
+        std::atomic<u32> next = 0;
+        auto work = [&]()
+        {
+            for (u32 k = next.fetch_add(1); k < count; k = next.fetch_add(1))
+                func(k);
+        };
+
+        std::vector<std::jthread> workers;
+        workers.reserve(threads - 1);
+        for (u32 t = 0; t < threads - 1; t++)
+            workers.emplace_back([&]() { profile::register_thread(); work(); });
+        work();
+    }
+}
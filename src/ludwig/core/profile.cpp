@@ -0,0 +1,287 @@
+#include "profile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace ludwig::core::profile
+{
+#ifdef LW_PROFILING
+    namespace
+    {
+        constexpr u32 ring_capacity = 1u << 16; // zone events kept per thread for the trace
+        constexpr u32 zone_slots    = 64;       // distinct zone names per thread in the totals
+
+        struct Event
+        {
+            const char* name;
+            u64 begin;
+            u64 end;
+        };
+
+        struct Totals
+        {
+            const char* name = nullptr;
+            u64 calls = 0;
+            u64 ns    = 0;
+        };
+
+        // written by its own thread only; `written` is published with release so an exporter
+        // on another thread sees complete events
+        struct ThreadBuffer
+        {
+            u32 tid = 0;
+            std::atomic<u64> written = 0;
+            std::vector<Event> ring;
+            Totals totals[zone_slots];
+            std::atomic<u64> counters[(u32)Counter::Count] = {};
+
+            explicit ThreadBuffer(u32 id) : tid(id), ring(ring_capacity) {}
+        };
+
+        std::mutex g_registry_mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> g_registry; // every buffer, kept for export after its thread exits
+        std::vector<ThreadBuffer*> g_free;                      // buffers of exited threads, reused by new ones
+        thread_local ThreadBuffer* t_buffer = nullptr;
+
+        // returns the thread's buffer to the free list when the thread exits, so threads spawned
+        // per call (parallel_for) reuse a few buffers instead of growing the registry
+        struct BufferHolder
+        {
+            ThreadBuffer* buffer = nullptr;
+
+            ~BufferHolder()
+            {
+                if (!buffer)
+                    return;
+                std::lock_guard<std::mutex> lock(g_registry_mutex);
+                g_free.push_back(buffer);
+                t_buffer = nullptr;
+            }
+        };
+        thread_local BufferHolder t_holder;
+
+        const std::chrono::steady_clock::time_point g_start = std::chrono::steady_clock::now();
+
+        ThreadBuffer& acquire()
+        {
+            {
+                std::lock_guard<std::mutex> lock(g_registry_mutex);
+                if (g_free.empty())
+                {
+                    g_registry.push_back(std::make_unique<ThreadBuffer>((u32)g_registry.size()));
+                    t_buffer = g_registry.back().get();
+                }
+                else
+                {
+                    t_buffer = g_free.back();
+                    g_free.pop_back();
+                }
+            }
+            t_holder.buffer = t_buffer;
+            return *t_buffer;
+        }
+
+        ThreadBuffer& buffer()
+        {
+            return t_buffer ? *t_buffer : acquire();
+        }
+
+        // the totals slot of name, found by pointer first and by content for the same
+        // literal from another translation unit
+        Totals* slot(ThreadBuffer& b, const char* name)
+        {
+            for (Totals& t : b.totals)
+            {
+                if (t.name == name)
+                    return &t;
+                if (!t.name)
+                {
+                    t.name = name;
+                    return &t;
+                }
+                if (!std::strcmp(t.name, name))
+                    return &t;
+            }
+            return nullptr; // more names than slots: trace only
+        }
+
+        void write_escaped(FILE* f, const char* s)
+        {
+            for (; *s; s++)
+            {
+                if (*s == '"' || *s == '\\')
+                    std::fputc('\\', f);
+                std::fputc(*s, f);
+            }
+        }
+    }
+
+    namespace detail
+    {
+        std::atomic<bool> g_enabled = false;
+
+        // nanoseconds since the profile started, never 0 so a Zone can use 0 for "not recording"
+        u64 now_ns()
+        {
+            return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_start).count() + 1;
+        }
+
+        void record(const char* name, u64 begin_ns, u64 end_ns)
+        {
+            ThreadBuffer& b = buffer();
+            u64 n = b.written.load(std::memory_order_relaxed);
+            b.ring[n % ring_capacity] = { name, begin_ns, end_ns };
+            b.written.store(n + 1, std::memory_order_release);
+
+            if (Totals* t = slot(b, name))
+            {
+                t->calls++;
+                t->ns += end_ns - begin_ns;
+            }
+        }
+
+        void count(Counter c, u64 n)
+        {
+            buffer().counters[(u32)c].fetch_add(n, std::memory_order_relaxed);
+        }
+    }
+
+    void register_thread()
+    {
+        buffer();
+    }
+
+    void enable(bool on)
+    {
+        if (on)
+            register_thread();
+        detail::g_enabled.store(on, std::memory_order_relaxed);
+    }
+    bool enabled() { return detail::g_enabled.load(std::memory_order_relaxed); }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        for (std::unique_ptr<ThreadBuffer>& b : g_registry)
+        {
+            b->written.store(0, std::memory_order_relaxed);
+            for (Totals& t : b->totals)
+                t = Totals();
+            for (std::atomic<u64>& c : b->counters)
+                c.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    u64 counter(Counter c)
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        u64 n = 0;
+        for (std::unique_ptr<ThreadBuffer>& b : g_registry)
+            n += b->counters[(u32)c].load(std::memory_order_relaxed);
+        return n;
+    }
+
+    bool write_chrome_trace(const std::string& path)
+    {
+        FILE* f = std::fopen(path.c_str(), "w");
+        if (!f)
+            return false;
+
+        static const char* counter_names[] = { "stations", "solves" };
+
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", f);
+        bool first = true;
+        u64 last_end = 0;
+        for (std::unique_ptr<ThreadBuffer>& b : g_registry)
+        {
+            std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"ludwig %u\"}}",
+                         first ? "" : ",\n", b->tid, b->tid);
+            first = false;
+
+            // the ring holds the most recent ring_capacity events, oldest first from `written`
+            u64 written = b->written.load(std::memory_order_acquire);
+            u64 begin = written > ring_capacity ? written - ring_capacity : 0;
+            for (u64 k = begin; k < written; k++)
+            {
+                const Event& e = b->ring[k % ring_capacity];
+                std::fputs(",\n{\"name\":\"", f);
+                write_escaped(f, e.name);
+                std::fprintf(f, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                             b->tid, e.begin * 1e-3, ( e.end - e.begin ) * 1e-3);
+                last_end = std::max(last_end, e.end);
+            }
+        }
+
+        // counter totals as one counter track sample at the end of the trace
+        for (u32 c = 0; c < (u32)Counter::Count; c++)
+        {
+            u64 n = 0;
+            for (std::unique_ptr<ThreadBuffer>& b : g_registry)
+                n += b->counters[c].load(std::memory_order_relaxed);
+            std::fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"%s\":%llu}}",
+                         first ? "" : ",\n", counter_names[c], last_end * 1e-3, counter_names[c], (unsigned long long)n);
+            first = false;
+        }
+        std::fputs("\n]}\n", f);
+        return std::fclose(f) == 0;
+    }
+
+    void print_summary(std::ostream& out)
+    {
+        std::vector<Totals> zones;
+        u64 wall_begin = ~0ull, wall_end = 0;
+        {
+            std::lock_guard<std::mutex> lock(g_registry_mutex);
+            for (std::unique_ptr<ThreadBuffer>& b : g_registry)
+            {
+                for (const Totals& t : b->totals)
+                {
+                    if (!t.name)
+                        break;
+                    auto it = std::find_if(zones.begin(), zones.end(), [&](const Totals& z) { return !std::strcmp(z.name, t.name); });
+                    if (it == zones.end())
+                        zones.push_back(t);
+                    else
+                    {
+                        it->calls += t.calls;
+                        it->ns    += t.ns;
+                    }
+                }
+                u64 written = b->written.load(std::memory_order_acquire);
+                u64 begin = written > ring_capacity ? written - ring_capacity : 0;
+                for (u64 k = begin; k < written; k++)
+                {
+                    wall_begin = std::min(wall_begin, b->ring[k % ring_capacity].begin);
+                    wall_end   = std::max(wall_end, b->ring[k % ring_capacity].end);
+                }
+            }
+        }
+        std::sort(zones.begin(), zones.end(), [](const Totals& a, const Totals& b) { return a.ns > b.ns; });
+        f64 wall = wall_end > wall_begin ? f64(wall_end - wall_begin) : 0.0;
+
+        out << std::setw(32) << std::left << " zone" << std::right << std::setw(12) << "calls" << std::setw(14) << "total [ms]"
+            << std::setw(14) << "mean [us]" << std::setw(10) << "% wall" << "\n";
+        for (const Totals& z : zones)
+            out << " " << std::setw(31) << std::left << z.name << std::right << std::setw(12) << z.calls
+                << std::setw(14) << std::fixed << std::setprecision(3) << z.ns * 1e-6
+                << std::setw(14) << z.ns * 1e-3 / std::max<u64>(z.calls, 1)
+                << std::setw(10) << std::setprecision(1) << ( wall > 0.0 ? 100.0 * z.ns / wall : 0.0 ) << "\n";
+        out << std::defaultfloat << " stations " << counter(Counter::Stations) << ", solves " << counter(Counter::Solves) << "\n";
+    }
+#else
+    void register_thread() {}
+    void enable(bool) {}
+    bool enabled() { return false; }
+    void reset() {}
+    bool write_chrome_trace(const std::string&) { return false; }
+    void print_summary(std::ostream&) {}
+    u64 counter(Counter) { return 0; }
+#endif
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <string>
+
+#include "vk/vk.h"
+
+// Hot-path instrumentation: scoped zones and event counters, recorded per thread and exported
+// as a Chrome / Perfetto trace (chrome://tracing, ui.perfetto.dev) and a summary table.
+//
+// Compiled into Debug and Release, compiled out in Dist (LW_DIST): the macros expand to
+// nothing there and the functions below do nothing. Recording is also off at run time until
+// profile::enable(), a disabled zone costs one relaxed atomic load.
+//
+// Every thread writes only its own buffer: a ring of the most recent zone events for the
+// trace and running per-zone totals for the summary, so recording takes no locks. A thread
+// takes its buffer from a free list in register_thread() (or on its first event if it never
+// called it) and hands it back when it exits, so the registry holds at most one buffer per
+// concurrently live thread; a reused buffer keeps the events of the threads before it. Zone
+// names must be string literals or otherwise outlive the profile. Export and reset are meant
+// for after the instrumented work, not while other threads are still recording.
+#if !defined(LW_DIST)
+    #define LW_PROFILING 1
+#endif
+
+namespace ludwig::core::profile
+{
+    enum class Counter : u8
+    {
+        Stations = 0, // streamwise stations advanced
+        Solves,       // tridiagonal (or block tridiagonal) solves
+        Count
+    };
+
+    // take the calling thread's buffer now, outside any timed zone; enable() does this for
+    // its own thread and the worker pools for theirs
+    void register_thread();
+
+    void enable(bool on = true);
+    bool enabled();
+
+    // drop every recorded event, total and counter
+    void reset();
+
+    // write the recorded zones and counters as Chrome trace event JSON, false on a file error
+    bool write_chrome_trace(const std::string& path);
+
+    // per zone: calls, total, mean and share of the profiled wall time, then the counters
+    void print_summary(std::ostream& out);
+
+    u64 counter(Counter c);
+
+#ifdef LW_PROFILING
+    namespace detail
+    {
+        extern std::atomic<bool> g_enabled;
+
+        u64 now_ns();
+        void record(const char* name, u64 begin_ns, u64 end_ns);
+        void count(Counter c, u64 n);
+    }
+
+    class Zone
+    {
+    public:
+        explicit Zone(const char* name) : m_name(name), m_begin(detail::g_enabled.load(std::memory_order_relaxed) ? detail::now_ns() : 0) {}
+        ~Zone()
+        {
+            if (m_begin)
+                detail::record(m_name, m_begin, detail::now_ns());
+        }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* m_name;
+        u64 m_begin;
+    };
+
+    inline void count(Counter c, u64 n = 1)
+    {
+        if (detail::g_enabled.load(std::memory_order_relaxed))
+            detail::count(c, n);
+    }
+#endif
+}
+
+#ifdef LW_PROFILING
+    #define LW_PROFILE_CONCAT_(a, b) a##b
+    #define LW_PROFILE_CONCAT(a, b) LW_PROFILE_CONCAT_(a, b)
+    #define LW_PROFILE_ZONE(name) ::ludwig::core::profile::Zone LW_PROFILE_CONCAT(lw_profile_zone_, __LINE__)(name)
+    #define LW_PROFILE_COUNT(counter, n) ::ludwig::core::profile::count(::ludwig::core::profile::Counter::counter, n)
+#else
+    #define LW_PROFILE_ZONE(name) ((void)0)
+    #define LW_PROFILE_COUNT(counter, n) ((void)0)
+#endif
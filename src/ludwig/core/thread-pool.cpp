@@ -0,0 +1,118 @@
+#include "thread-pool.h"
+#include "profile.h"
+
+namespace ludwig::core
+{
+    ThreadPool::ThreadPool(u32 threads)
+    {
+        threads = std::max(threads, 1u);
+        for (u32 t = 0; t < threads; t++)
+            m_ranges.push_back(std::make_unique<Range>());
+        m_threads.reserve(threads);
+        for (u32 t = 0; t < threads; t++)
+            m_threads.emplace_back([this, t](std::stop_token stop) { worker(stop, t); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            for (std::jthread& thread : m_threads)
+                thread.request_stop();
+        }
+        m_start.notify_all();
+    }
+
+    void ThreadPool::for_each(u32 count, const Task& task)
+    {
+        if (count == 0)
+            return;
+
+        std::unique_lock lock(m_mutex);
+        const u32 threads = size();
+        for (u32 t = 0; t < threads; t++)
+        {
+            std::lock_guard range_lock(m_ranges[t]->mutex);
+            m_ranges[t]->begin = (u32)( (u64)count * t / threads );
+            m_ranges[t]->end   = (u32)( (u64)count * ( t + 1 ) / threads );
+        }
+
+        m_task = &task;
+        m_remaining = count;
+        m_generation++;
+        m_start.notify_all();
+        // also wait for every worker to leave its take() loop, none may touch the next ranges with this task
+        m_done.wait(lock, [this]() { return m_remaining == 0 && m_active == 0; });
+        m_task = nullptr;
+    }
+
+    bool ThreadPool::take(u32 id, u32& index)
+    {
+        Range& own = *m_ranges[id];
+        {
+            std::lock_guard lock(own.mutex);
+            if (own.begin < own.end)
+            {
+                index = own.begin++;
+                return true;
+            }
+        }
+
+        // steal the back half of another worker's block, starting with the next neighbour
+        const u32 threads = (u32)m_ranges.size();
+        for (u32 k = 1; k < threads; k++)
+        {
+            Range& victim = *m_ranges[( id + k ) % threads];
+            std::scoped_lock lock(victim.mutex, own.mutex);
+            u32 left = victim.end - victim.begin;
+            if (left == 0)
+                continue;
+
+            u32 mid = victim.end - ( left + 1 ) / 2;
+            own.begin = mid + 1;
+            own.end = victim.end;
+            victim.end = mid;
+            index = mid;
+            return true;
+        }
+        return false;
+    }
+
+    void ThreadPool::worker(std::stop_token stop, u32 id)
+    {
+        profile::register_thread();
+
+        u64 seen = 0;
+        for (;;)
+        {
+            const Task* task = nullptr;
+            {
+                std::unique_lock lock(m_mutex);
+                m_start.wait(lock, [&]() { return m_generation != seen || stop.stop_requested(); });
+                if (stop.stop_requested())
+                    return;
+                seen = m_generation;
+                task = m_task;
+                if (!task)
+                    continue;
+                m_active++;
+            }
+
+            u32 done = 0;
+            u32 index = 0;
+            while (take(id, index))
+            {
+                (*task)(index, id);
+                done++;
+            }
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_remaining -= done;
+                m_active--;
+                if (m_remaining == 0 && m_active == 0)
+                    m_done.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "vk/vk.h"
+#include "parallel.h"
+
+namespace ludwig::core
+{
+    // Persistent workers for coarse independent tasks (whole cases). for_each() deals the
+    // indices out in contiguous blocks, one per worker; a worker that runs dry steals the
+    // back half of the first non-empty block after its own in worker order, so uneven task
+    // costs still balance.
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void(u32 index, u32 worker)>;
+
+        explicit ThreadPool(u32 threads = hardware_threads());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        u32 size() const { return (u32)m_threads.size(); }
+
+        // runs task(k, worker) for every k in [0, count) and blocks until all are done;
+        // worker < size() identifies the thread, for per-thread state
+        void for_each(u32 count, const Task& task);
+
+    private:
+        struct Range
+        {
+            std::mutex mutex;
+            u32 begin = 0;
+            u32 end = 0;
+        };
+
+        void worker(std::stop_token stop, u32 id);
+        bool take(u32 id, u32& index);
+
+    private:
+        std::vector<std::unique_ptr<Range>> m_ranges;
+        const Task* m_task = nullptr;
+        u64 m_generation = 0;
+        u32 m_remaining = 0; // tasks not yet finished in the current for_each
+        u32 m_active = 0;    // workers inside their take() loop
+
+        std::mutex m_mutex;
+        std::condition_variable m_start;
+        std::condition_variable m_done;
+        std::vector<std::jthread> m_threads;
+    };
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+
+#include "vk/vk.h"
+#include "ludwig/types/types.h"
+
+namespace ludwig::core
+{
+    // Non-owning strided views into Matrix, Array and Array3 storage. Taking a view copies
+    // nothing: it is a pointer, extents and strides, and indexing goes straight to the
+    // container's memory. The bulk operations check for unit stride and then run a plain
+    // contiguous loop (a memcpy for copies), so a station row of a Matrix costs the same as a
+    // raw pointer, while a strided line (a station of an Array3, a spanwise profile) still
+    // needs no gather into a temporary.
+
+    // n values, entry k at data[k * stride]
+    template<typename T>
+    struct ArrayView
+    {
+        T*  data   = nullptr;
+        u32 n      = 0;
+        i64 stride = 1;
+
+        ArrayView() = default;
+        ArrayView(T* d, u32 count, i64 s = 1) : data(d), n(count), stride(s) {}
+
+        // a view of mutable values is also a view of const ones
+        operator ArrayView<const T>() const requires ( !std::is_const_v<T> ) { return { data, n, stride }; }
+
+        T& operator[](u32 k) const { return data[k * stride]; }
+        u32 size() const { return n; }
+        bool contiguous() const { return stride == 1; }
+
+        // entries first .. first + count - 1
+        ArrayView sub(u32 first, u32 count) const { return { data + first * stride, count, stride }; }
+
+        void copy_to(std::remove_const_t<T>* out) const
+        {
+            if (contiguous())
+                std::copy(data, data + n, out);
+            else
+                for (u32 k = 0; k < n; k++)
+                    out[k] = data[k * stride];
+        }
+
+        void copy_from(const std::remove_const_t<T>* in) const requires ( !std::is_const_v<T> )
+        {
+            if (contiguous())
+                std::copy(in, in + n, data);
+            else
+                for (u32 k = 0; k < n; k++)
+                    data[k * stride] = in[k];
+        }
+
+        void fill(const std::remove_const_t<T>& value) const requires ( !std::is_const_v<T> )
+        {
+            if (contiguous())
+                std::fill(data, data + n, value);
+            else
+                for (u32 k = 0; k < n; k++)
+                    data[k * stride] = value;
+        }
+    };
+
+    // ni x nj x nk sub-block, entry (i, j, k) at data[i si + j sj + k sk]
+    template<typename T>
+    struct BlockView
+    {
+        T*  data = nullptr;
+        u32 ni = 0, nj = 0, nk = 1;
+        i64 si = 0, sj = 0, sk = 0;
+
+        operator BlockView<const T>() const requires ( !std::is_const_v<T> ) { return { data, ni, nj, nk, si, sj, sk }; }
+
+        T& operator()(u32 i, u32 j, u32 k = 0) const { return data[i * si + j * sj + k * sk]; }
+        u64 size() const { return (u64)ni * nj * nk; }
+
+        // the sub-block [i0, i1) x [j0, j1) x [k0, k1), the Array3::slice of a view without the copy
+        BlockView slice(u32 i0, u32 i1, u32 j0, u32 j1, u32 k0 = 0, u32 k1 = 1) const
+        {
+            return { &(*this)(i0, j0, k0), i1 - i0, j1 - j0, k1 - k0, si, sj, sk };
+        }
+
+        // lines through the block along i, j or k
+        ArrayView<T> line_i(u32 j, u32 k = 0) const { return { &(*this)(0, j, k), ni, si }; }
+        ArrayView<T> line_j(u32 i, u32 k = 0) const { return { &(*this)(i, 0, k), nj, sj }; }
+        ArrayView<T> line_k(u32 i, u32 j) const     { return { &(*this)(i, j, 0), nk, sk }; }
+
+        // the i-j plane at k
+        BlockView plane(u32 k) const { return slice(0, ni, 0, nj, k, k + 1); }
+    };
+
+    // position and wall-normal u, v profiles of one streamwise station, viewed in place
+    template<typename T>
+    struct StationView
+    {
+        f64 x = 0.0;
+        ArrayView<T> u;
+        ArrayView<T> v;
+
+        operator StationView<const T>() const requires ( !std::is_const_v<T> ) { return { x, u, v }; }
+
+        u32 jmax() const { return u.size(); }
+    };
+
+    // Matrix(i, j) is row-major: (i, j) at i dim2 + j
+    template<typename T> BlockView<T>       view(Matrix<T>& m)       { return { &m(0, 0), m.dim1, m.dim2, 1, (i64)m.dim2, 1, 0 }; }
+    template<typename T> BlockView<const T> view(const Matrix<T>& m) { return { &m(0, 0), m.dim1, m.dim2, 1, (i64)m.dim2, 1, 0 }; }
+
+    // Array3(i, j, k) and Array(x, y, z) are i fastest
+    template<typename T> BlockView<T> view(Array3<T>& a) { return { &a(0, 0, 0), a.ni, a.nj, a.nk, 1, (i64)a.ni, (i64)a.ni * a.nj }; }
+    template<typename T> BlockView<T> view(Array<T>& a, u32 t = 0)
+    {
+        return { &a(0, 0, 0, t), a.dims.x, a.dims.y, a.dims.z, 1, (i64)a.dims.x, (i64)a.dims.x * a.dims.y };
+    }
+
+    // the jmax wall-normal values of station i: contiguous in a Matrix(i, j), stride ni in an Array3
+    template<typename T> ArrayView<T>       station(Matrix<T>& m, u32 i)             { return view(m).line_j(i); }
+    template<typename T> ArrayView<const T> station(const Matrix<T>& m, u32 i)       { return view(m).line_j(i); }
+    template<typename T> ArrayView<T>       station(Array3<T>& a, u32 i, u32 k = 0)  { return view(a).line_j(i, k); }
+
+    template<typename T>
+    StationView<T> station(f64 x, Matrix<T>& u, Matrix<T>& v, u32 i) { return { x, station(u, i), station(v, i) }; }
+    template<typename T>
+    StationView<const T> station(f64 x, const Matrix<T>& u, const Matrix<T>& v, u32 i) { return { x, station(u, i), station(v, i) }; }
+}
@@ -0,0 +1,31 @@
+#include "case.h"
+
+#include <cmath>
+
+namespace ludwig
+{
+    f64 BoundaryLayerCase::thickness(f64 x) const
+    {
+        f64 Re = edge_velocity(x) * x / nu();
+        return 5.0 * x / std::sqrt(Re);
+    }
+
+    MeshSpec BoundaryLayerCase::mesh_spec() const
+    {
+        MeshSpec spec;
+        spec.x0 = x_start * plate_length;
+        spec.x1 = x_end * plate_length;
+        spec.y0 = 0.0;
+        spec.y1 = height * plate_length;
+        spec.imax = imax;
+        spec.jmax = jmax;
+        spec.clustering = clustering;
+        spec.stretching = stretching;
+        return spec;
+    }
+
+    void inflow_profile(const BoundaryLayerCase& c, const std::vector<f64>& y, f64 x0, f64 x1, f64* u, f64* v)
+    {
+        inflow_profile(y, c.edge_velocity(x0), c.edge_velocity(x1), c.thickness(x0), c.thickness(x1), x1 - x0, u, v);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "vk/vk.h"
+#include "ludwig/mesh/structured-mesh.h"
+
+namespace ludwig
+{
+    // One boundary-layer case: fluid, free stream and plate geometry. The march covers
+    // [x_start, x_end] * plate_length with the edge velocity Ue = U0 (1 - deceleration x / L),
+    // deceleration = 1 is Howarth's retarded flow, 0 the flat plate.
+    struct BoundaryLayerCase
+    {
+        f64 density      = 1.182;
+        f64 viscosity    = 1.83e-5;
+        f64 U0           = 1.0;
+        f64 deceleration = 1.0;
+
+        f64 plate_length = 0.2;
+        f64 x_start      = 0.005; // fractions of plate_length
+        f64 x_end        = 0.13;
+        f64 height       = 0.02;
+
+        // laminar upstream of x_transition (fraction of plate_length), eddy viscosity downstream
+        bool turbulent     = false;
+        f64  x_transition  = 0.02;
+
+        // energy equation with temperature-dependent properties, isothermal wall
+        bool heated            = false;
+        f64  edge_temperature  = 298.15;
+        f64  wall_temperature  = 330.0;
+
+        u32 imax = 10;
+        u32 jmax = 100;
+        Clustering clustering = Clustering::Uniform;
+        f64 stretching = 1.0;
+
+        f64 nu() const { return viscosity / density; }
+        f64 edge_velocity(f64 x) const { return U0 * ( 1.0 - deceleration * x / plate_length ); }
+
+        // boundary-layer thickness estimate 5 x / sqrt(Re_x) used for the inflow profile
+        f64 thickness(f64 x) const;
+
+        MeshSpec mesh_spec() const;
+    };
+
+    // inflow station: square-root profile of thickness(x0) and the v that balances its growth
+    // to station 1 at x1. u and v hold jmax values, the wall node stays at zero.
+    void inflow_profile(const BoundaryLayerCase& c, const std::vector<f64>& y, f64 x0, f64 x1, f64* u, f64* v);
+
+    // the same profile from edge velocities and thicknesses at x0 and x0 + dx, templated so the
+    // optimizer can carry derivatives with respect to them
+    template<typename T>
+    void inflow_profile(const std::vector<f64>& y, const T& Ue0, const T& Ue1, const T& del0, const T& del1, f64 dx, T* u, T* v)
+    {
+        using std::sqrt;
+        const u32 jmax = (u32)y.size();
+
+        u[0] = T(0);
+        v[0] = T(0);
+        for (u32 j = 1; j < jmax; j++)
+            u[j] = y[j] >= del0 ? Ue0 : Ue0 * sqrt(y[j] / del0);
+        u[jmax-1] = Ue0;
+
+        for (u32 j = 1; j < jmax; j++)
+        {
+            f64 dy = y[j] - y[j-1];
+            v[j] = v[j-1] - dy * ( ( u[j] / Ue0 ) * ( Ue1 - Ue0 ) / dx - y[j] / del0 * ( del1 - del0 ) / dx * ( u[j] - u[j-1] ) / dy );
+        }
+    }
+}
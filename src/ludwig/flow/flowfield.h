@@ -1,20 +1,99 @@
 #pragma once
 
+#include <type_traits>
+
 #include "vk/vk.h"
+#include "ludwig/core/aligned.h"
 
 namespace ludwig 
 {
     typedef Array<f64>  ScalarField;
     typedef Array<Vec2> VectorField;
-    
-    struct FlowField
+
+    // proxy returned by the SoA vector fields so velocity(i,j).x reads and writes the x plane
+    struct Vec2Ref
+    {
+        f64& x;
+        f64& y;
+
+        operator Vec2() const { return Vec2(x, y); }
+        Vec2Ref& operator=(const Vec2& w) { x = w.x; y = w.y; return *this; }
+    };
+
+    // one scalar per node, station i is a contiguous, 64-byte aligned row of jmax values
+    struct ScalarPlane
+    {
+        u32 imax   = 0;
+        u32 jmax   = 0;
+        u32 stride = 0; // jmax padded to whole cache lines
+        core::AlignedVector<f64> data;
+
+        ScalarPlane() = default;
+        ScalarPlane(u32 ni, u32 nj, core::Arena* arena = nullptr)
+            : imax(ni), jmax(nj), stride(core::padded_size<f64>(nj)), data((u64)ni * stride, 0.0, core::AlignedAllocator<f64>(arena)) {}
+
+        f64& operator()(u32 i, u32 j) { return data[(u64)i * stride + j]; }
+        const f64& operator()(u32 i, u32 j) const { return data[(u64)i * stride + j]; }
+
+        f64* row(u32 i) { return data.data() + (u64)i * stride; }
+        const f64* row(u32 i) const { return data.data() + (u64)i * stride; }
+    };
+
+    // two component field stored as separate x and y planes
+    struct VectorPlanes
+    {
+        ScalarPlane x;
+        ScalarPlane y;
+
+        VectorPlanes() = default;
+        VectorPlanes(u32 ni, u32 nj, core::Arena* arena = nullptr) : x(ni, nj, arena), y(ni, nj, arena) {}
+
+        Vec2Ref operator()(u32 i, u32 j) { return Vec2Ref{ x(i, j), y(i, j) }; }
+        Vec2 operator()(u32 i, u32 j) const { return Vec2(x(i, j), y(i, j)); }
+    };
+
+    // storage policies for BasicFlowField
+    struct AoS
+    {
+        using Scalar = ScalarField;
+        using Vector = VectorField; // interleaved x, y
+    };
+
+    struct SoA
+    {
+        using Scalar = ScalarPlane;
+        using Vector = VectorPlanes; // u, v, x, y in separate planes, wall-normal sweeps stream one of them
+    };
+
+    template<typename Layout = AoS>
+    struct BasicFlowField
     {
-        VectorField position; // position(i,j).x
-        VectorField velocity; // u = velocity(i,j).x, v = velocity(i,j).y
-        ScalarField pressure; // pressure(i,j)
-        ScalarField density;
-        ScalarField viscosity;
+        using Scalar = typename Layout::Scalar;
+        using Vector = typename Layout::Vector;
+
+        u32 imax = 0;    // streamwise stations
+        u32 jmax = 0;    // wall-normal nodes
+        Vector position; // position(i,j).x
+        Vector velocity; // u = velocity(i,j).x, v = velocity(i,j).y
+        Scalar pressure; // pressure(i,j)
+        Scalar density;
+        Scalar viscosity;
+
+        BasicFlowField() = default;
+        BasicFlowField(u32 imax, u32 jmax)
+            : imax(imax), jmax(jmax), position(imax, jmax), velocity(imax, jmax), pressure(imax, jmax), density(imax, jmax), viscosity(imax, jmax) {}
+
+        // SoA only: every plane carved back to back from one arena
+        BasicFlowField(u32 imax, u32 jmax, core::Arena& arena) requires std::is_same_v<Layout, SoA>
+            : imax(imax), jmax(jmax), position(imax, jmax, &arena), velocity(imax, jmax, &arena), pressure(imax, jmax, &arena),
+              density(imax, jmax, &arena), viscosity(imax, jmax, &arena) {}
+
+        // bytes an arena needs to hold a SoA field of imax x jmax nodes
+        static u64 arena_bytes(u32 imax, u32 jmax) { return 7 * (u64)imax * core::padded_size<f64>(jmax) * sizeof(f64); }
     };
 
+    typedef BasicFlowField<AoS> FlowField;
+    typedef BasicFlowField<SoA> FlowFieldSoA;
+
    // FlowField make_flow_field(Mesh& mesh, 
 }
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cmath>
+
+#include "vk/vk.h"
+
+namespace ludwig
+{
+    // Sutherland's law mu(T) = mu_ref (T / T_ref)^1.5 (T_ref + S) / (T + S), air by default
+    struct Sutherland
+    {
+        f64 mu_ref = 1.716e-5;
+        f64 T_ref  = 273.15;
+        f64 S      = 110.4;
+
+        f64 operator()(f64 T) const
+        {
+            f64 t = T / T_ref;
+            return mu_ref * t * std::sqrt(t) * ( T_ref + S ) / ( T + S );
+        }
+    };
+
+    // thermally perfect gas at constant pressure: rho = p / (R T), constant cp and Prandtl number
+    struct IdealGas
+    {
+        f64 R  = 287.05;
+        f64 cp = 1005.0;
+        f64 Pr = 0.71;
+    };
+
+    // temperature-dependent properties of the boundary layer, the pressure is constant across it
+    struct GasProperties
+    {
+        Sutherland sutherland;
+        IdealGas gas;
+        f64 pressure = 101325.0;
+
+        f64 viscosity(f64 T) const { return sutherland(T); }
+        f64 density(f64 T) const { return pressure / ( gas.R * T ); }
+        // constant Prandtl number, from the viscosity at the same temperature
+        f64 conductivity(f64 mu) const { return mu * gas.cp / gas.Pr; }
+    };
+}
@@ -0,0 +1,124 @@
+#include "cgns.h"
+
+#include "cgnslib.h"
+#include "ludwig/core/profile.h"
+
+namespace ludwig::io
+{
+    CgnsWriter::CgnsWriter()
+    {
+        m_thread = std::jthread([this](std::stop_token stop) { worker(stop); });
+    }
+
+    CgnsWriter::~CgnsWriter()
+    {
+        flush();
+        {
+            std::lock_guard lock(m_mutex);
+            m_thread.request_stop();
+        }
+        m_cv.notify_all();
+    }
+
+    FieldSnapshot& CgnsWriter::acquire()
+    {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this]() { return m_queued < m_buffers.size(); });
+        return m_buffers[m_next];
+    }
+
+    void CgnsWriter::submit()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_next = ( m_next + 1 ) % m_buffers.size();
+            m_queued++;
+        }
+        m_cv.notify_all();
+    }
+
+    bool CgnsWriter::flush()
+    {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this]() { return m_queued == 0; });
+        bool ok = !m_failed;
+        m_failed = false;
+        return ok;
+    }
+
+    void CgnsWriter::worker(std::stop_token stop)
+    {
+        for (;;)
+        {
+            u32 slot = 0;
+            {
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, [&]() { return m_queued > 0 || stop.stop_requested(); });
+                if (m_queued == 0)
+                    return;
+                // oldest queued snapshot
+                slot = ( m_next + m_buffers.size() - m_queued ) % m_buffers.size();
+            }
+
+            bool ok = write_file(m_buffers[slot]);
+
+            {
+                std::lock_guard lock(m_mutex);
+                m_queued--;
+                if (ok)
+                    m_written++;
+                else
+                    m_failed = true;
+            }
+            m_cv.notify_all();
+        }
+    }
+
+    bool CgnsWriter::write_file(const FieldSnapshot& s)
+    {
+        LW_PROFILE_ZONE("io/cgns-write");
+        static const char* names[FieldSnapshot::Count] = {
+            "CoordinateX", "CoordinateY", "VelocityX", "VelocityY", "Pressure", "Density", "ViscosityMolecular"
+        };
+
+        auto fail = [&](int fn) {
+            std::lock_guard lock(m_mutex);
+            m_error = s.path + ": " + cg_get_error();
+            if (fn)
+                cg_close(fn);
+            return false;
+        };
+
+        int fn = 0, B = 0, Z = 0, S = 0, index = 0;
+        if (cg_open(s.path.c_str(), CG_MODE_WRITE, &fn) != CG_OK)
+            return fail(0);
+        if (cg_base_write(fn, "Base", 2, 2, &B) != CG_OK)
+            return fail(fn);
+
+        // vertex, cell and boundary vertex counts per index direction, i streamwise
+        cgsize_t size[6] = { (cgsize_t)s.imax, (cgsize_t)s.jmax, (cgsize_t)s.imax - 1, (cgsize_t)s.jmax - 1, 0, 0 };
+        if (cg_zone_write(fn, B, "Zone", size, CGNS_ENUMV(Structured), &Z) != CG_OK)
+            return fail(fn);
+        if (cg_sol_write(fn, B, Z, "FlowSolution", CGNS_ENUMV(Vertex), &S) != CG_OK)
+            return fail(fn);
+
+        m_transposed.resize((u64)s.imax * s.jmax);
+        for (u32 k = 0; k < FieldSnapshot::Count; k++)
+        {
+            const std::vector<f64>& plane = s.planes[k];
+            for (u32 i = 0; i < s.imax; i++)
+                for (u32 j = 0; j < s.jmax; j++)
+                    m_transposed[(u64)j * s.imax + i] = plane[(u64)i * s.jmax + j];
+
+            int status = k <= FieldSnapshot::Y
+                ? cg_coord_write(fn, B, Z, CGNS_ENUMV(RealDouble), names[k], m_transposed.data(), &index)
+                : cg_field_write(fn, B, Z, S, CGNS_ENUMV(RealDouble), names[k], m_transposed.data(), &index);
+            if (status != CG_OK)
+                return fail(fn);
+        }
+
+        if (cg_close(fn) != CG_OK)
+            return fail(0);
+        return true;
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "vk/vk.h"
+#include "ludwig/flow/flowfield.h"
+
+namespace ludwig::io
+{
+    // copy of a FlowField taken on the solver thread, one plane per written quantity,
+    // stored station by station (i * jmax + j)
+    struct FieldSnapshot
+    {
+        enum Plane : u32 { X = 0, Y, U, V, Pressure, Density, Viscosity, Count };
+
+        u32 imax = 0;
+        u32 jmax = 0;
+        std::string path;
+        std::array<std::vector<f64>, Plane::Count> planes;
+
+        // the first `stations` stations of f, all of them when 0
+        template<typename Layout>
+        void copy(const BasicFlowField<Layout>& f, u32 stations = 0)
+        {
+            imax = stations ? std::min(stations, f.imax) : f.imax;
+            jmax = f.jmax;
+            for (std::vector<f64>& plane : planes)
+                plane.resize((u64)imax * jmax);
+
+            for (u32 i = 0; i < imax; i++)
+            {
+                u64 row = (u64)i * jmax;
+                for (u32 j = 0; j < jmax; j++)
+                {
+                    Vec2 p = f.position(i, j);
+                    Vec2 w = f.velocity(i, j);
+                    planes[X][row + j] = p.x;
+                    planes[Y][row + j] = p.y;
+                    planes[U][row + j] = w.x;
+                    planes[V][row + j] = w.y;
+                    planes[Pressure][row + j]  = f.pressure(i, j);
+                    planes[Density][row + j]   = f.density(i, j);
+                    planes[Viscosity][row + j] = f.viscosity(i, j);
+                }
+            }
+        }
+    };
+
+    // Writes FlowFields as single-zone structured CGNS files on a background thread.
+    //
+    // write() copies the field into one of two snapshot buffers and returns, the worker
+    // transposes it to the CGNS (i fastest) order and writes grid coordinates and a vertex
+    // FlowSolution (VelocityX, VelocityY, Pressure, Density, ViscosityMolecular). The solver
+    // only waits when both buffers are still queued, i.e. when it produces snapshots faster
+    // than the disk takes them.
+    class CgnsWriter
+    {
+    public:
+        CgnsWriter();
+        ~CgnsWriter(); // writes everything still queued
+
+        CgnsWriter(const CgnsWriter&) = delete;
+        CgnsWriter& operator=(const CgnsWriter&) = delete;
+
+        // writes the first `stations` stations of f, all of them when 0
+        template<typename Layout>
+        void write(const BasicFlowField<Layout>& f, const std::string& path, u32 stations = 0)
+        {
+            FieldSnapshot& snapshot = acquire();
+            snapshot.copy(f, stations);
+            snapshot.path = path;
+            submit();
+        }
+
+        // block until every queued snapshot is on disk, false if any write failed since the last flush
+        bool flush();
+
+        const std::string& last_error() const { return m_error; }
+        u64 written() const { return m_written; }
+
+    private:
+        FieldSnapshot& acquire();
+        void submit();
+        void worker(std::stop_token stop);
+        bool write_file(const FieldSnapshot& snapshot);
+
+    private:
+        std::array<FieldSnapshot, 2> m_buffers;
+        u32 m_next = 0;      // buffer the next write() fills
+        u32 m_queued = 0;    // snapshots submitted and not yet written, at most 2
+        bool m_failed = false;
+        std::string m_error;
+        u64 m_written = 0;
+        std::vector<f64> m_transposed; // worker side, CGNS order
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::jthread m_thread;
+    };
+}
@@ -0,0 +1,177 @@
+#include "checkpoint.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef LW_PLATFORM_WINDOWS
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace ludwig::io
+{
+    static u64 align_up(u64 n) { return ( n + core::cache_line - 1 ) / core::cache_line * core::cache_line; }
+
+    // every section the header describes has to lie inside the image, with the lengths the
+    // writer lays out, before any of it is read in place
+    static bool sections_fit(const CheckpointHeader& h)
+    {
+        if (h.stride < h.jmax)
+            return false;
+        u64 lengths[CheckpointHeader::Count] = { h.imax, h.jmax, h.imax, h.imax };
+        for (u32 k = CheckpointHeader::PositionX; k < CheckpointHeader::Count; k++)
+            lengths[k] = (u64)h.imax * h.stride;
+
+        for (u32 k = 0; k < CheckpointHeader::Count; k++)
+        {
+            // written as a division so a corrupt length cannot wrap the sum
+            if (h.offsets[k] < sizeof(CheckpointHeader) || h.offsets[k] > h.bytes
+                || lengths[k] > ( h.bytes - h.offsets[k] ) / sizeof(f64))
+                return false;
+        }
+        return true;
+    }
+
+    CheckpointHeader& CheckpointWriter::layout(const StructuredMesh& mesh, const MarchingState& state)
+    {
+        CheckpointHeader h;
+        std::memcpy(h.magic, CheckpointHeader::magic_bytes, sizeof(h.magic));
+        h.version = CheckpointHeader::current_version;
+        h.imax = mesh.imax;
+        h.jmax = mesh.jmax;
+        h.stride = core::padded_size<f64>(mesh.jmax);
+        h.station = state.station;
+        h.nu = state.nu;
+
+        u64 lengths[CheckpointHeader::Count] = { h.imax, h.jmax, h.imax, h.imax };
+        for (u32 k = CheckpointHeader::PositionX; k < CheckpointHeader::Count; k++)
+            lengths[k] = (u64)h.imax * h.stride;
+
+        u64 offset = align_up(sizeof(CheckpointHeader));
+        for (u32 k = 0; k < CheckpointHeader::Count; k++)
+        {
+            h.offsets[k] = offset;
+            offset = align_up(offset + lengths[k] * sizeof(f64));
+        }
+        h.bytes = offset;
+
+        // padding stays zero, the image is only ever grown
+        if (m_image.size() < h.bytes)
+            m_image.resize(h.bytes, 0);
+        std::memcpy(m_image.data(), &h, sizeof(h));
+
+        auto copy = [&](u32 k, const std::vector<f64>& values) {
+            std::memset(section(h, k), 0, lengths[k] * sizeof(f64));
+            std::memcpy(section(h, k), values.data(), std::min<u64>(values.size(), lengths[k]) * sizeof(f64));
+        };
+        copy(CheckpointHeader::X, mesh.x);
+        copy(CheckpointHeader::Y, mesh.y);
+        copy(CheckpointHeader::Ue, state.Ue);
+        copy(CheckpointHeader::Del1, state.del1);
+
+        return *reinterpret_cast<CheckpointHeader*>(m_image.data());
+    }
+
+    bool CheckpointWriter::flush(const std::string& path, const CheckpointHeader& h)
+    {
+#ifdef LW_PLATFORM_WINDOWS
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        // WriteFile takes a DWORD count, images past 4 GB go out in 1 GB chunks
+        u64 done = 0;
+        while (done < h.bytes)
+        {
+            DWORD chunk = DWORD(std::min<u64>(h.bytes - done, 1ull << 30));
+            DWORD written = 0;
+            if (!WriteFile(file, m_image.data() + done, chunk, &written, nullptr) || written == 0)
+                break;
+            done += written;
+        }
+        CloseHandle(file);
+        return done == h.bytes;
+#else
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            return false;
+        // one write for the whole image, the loop only continues past the per-call size cap
+        u64 done = 0;
+        while (done < h.bytes)
+        {
+            ssize_t n = ::write(fd, m_image.data() + done, h.bytes - done);
+            if (n <= 0)
+                break;
+            done += u64(n);
+        }
+        ::close(fd);
+        return done == h.bytes;
+#endif
+    }
+
+    bool MappedCheckpoint::open(const std::string& path)
+    {
+        close();
+#ifdef LW_PLATFORM_WINDOWS
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER size;
+        GetFileSizeEx(file, &size);
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        m_file = file;
+        m_mapping = mapping;
+        m_data = static_cast<const u8*>(data);
+        m_size = u64(size.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        void* data = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+            data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        m_data = data == MAP_FAILED ? nullptr : static_cast<const u8*>(data);
+        m_size = m_data ? u64(st.st_size) : 0;
+#endif
+        if (!m_data)
+        {
+            close();
+            return false;
+        }
+
+        const CheckpointHeader& h = header();
+        if (m_size < sizeof(CheckpointHeader) || std::memcmp(h.magic, CheckpointHeader::magic_bytes, sizeof(h.magic)) != 0
+            || h.version != CheckpointHeader::current_version || h.bytes > m_size || !sections_fit(h))
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void MappedCheckpoint::close()
+    {
+#ifdef LW_PLATFORM_WINDOWS
+        if (m_data)
+            UnmapViewOfFile(m_data);
+        if (m_mapping)
+            CloseHandle(m_mapping);
+        if (m_file)
+            CloseHandle(m_file);
+        m_file = nullptr;
+        m_mapping = nullptr;
+#else
+        if (m_data)
+            munmap(const_cast<u8*>(m_data), m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "vk/vk.h"
+#include "ludwig/core/aligned.h"
+#include "ludwig/flow/flowfield.h"
+#include "ludwig/mesh/structured-mesh.h"
+
+namespace ludwig::io
+{
+    // where a march stands: the next station to compute from and the per-station inputs
+    struct MarchingState
+    {
+        u32 station = 0;
+        f64 nu = 0.0;
+        std::vector<f64> Ue;   // edge velocity, imax
+        std::vector<f64> del1; // boundary-layer thickness estimate, imax
+    };
+
+    // Binary checkpoint: a fixed header followed by 64-byte aligned f64 sections, the mesh
+    // and marching state arrays and one station-major plane per FlowField quantity with the
+    // SoA row stride, so a mapped file can be read in place like a FlowFieldSoA.
+    struct CheckpointHeader
+    {
+        enum Section : u32 { X = 0, Y, Ue, Del1, PositionX, PositionY, VelocityX, VelocityY, Pressure, Density, Viscosity, Count };
+
+        static constexpr char magic_bytes[8] = { 'L', 'W', 'C', 'K', 'P', 'T', '\0', '\0' };
+        static constexpr u32 current_version = 1;
+
+        char magic[8] = {};
+        u32 version = 0;
+        u32 imax = 0;
+        u32 jmax = 0;
+        u32 stride = 0;  // f64 per station row in the field planes
+        u32 station = 0;
+        u32 reserved = 0;
+        f64 nu = 0.0;
+        u64 bytes = 0;   // file size
+        u64 offsets[Section::Count] = {};
+    };
+
+    // Lays out mesh, state and field in one image and writes it with a single write call.
+    // The image buffer is kept between calls, repeated checkpoints of one case do not allocate.
+    class CheckpointWriter
+    {
+    public:
+        template<typename Layout>
+        bool write(const std::string& path, const StructuredMesh& mesh, const MarchingState& state, const BasicFlowField<Layout>& f)
+        {
+            CheckpointHeader& h = layout(mesh, state);
+            f64* planes[7];
+            for (u32 k = 0; k < 7; k++)
+                planes[k] = section(h, CheckpointHeader::PositionX + k);
+
+            for (u32 i = 0; i < h.imax; i++)
+            {
+                u64 row = (u64)i * h.stride;
+                for (u32 j = 0; j < h.jmax; j++)
+                {
+                    Vec2 p = f.position(i, j);
+                    Vec2 w = f.velocity(i, j);
+                    planes[0][row + j] = p.x;
+                    planes[1][row + j] = p.y;
+                    planes[2][row + j] = w.x;
+                    planes[3][row + j] = w.y;
+                    planes[4][row + j] = f.pressure(i, j);
+                    planes[5][row + j] = f.density(i, j);
+                    planes[6][row + j] = f.viscosity(i, j);
+                }
+            }
+            return flush(path, h);
+        }
+
+    private:
+        CheckpointHeader& layout(const StructuredMesh& mesh, const MarchingState& state);
+        f64* section(const CheckpointHeader& h, u32 k) { return reinterpret_cast<f64*>(m_image.data() + h.offsets[k]); }
+        bool flush(const std::string& path, const CheckpointHeader& h);
+
+    private:
+        core::AlignedVector<u8> m_image;
+    };
+
+    // Read-only memory map of a checkpoint. Sections are used in place (zero copy) through
+    // section()/row(), restore() copies them back into a mesh, state and field to resume.
+    class MappedCheckpoint
+    {
+    public:
+        MappedCheckpoint() = default;
+        ~MappedCheckpoint() { close(); }
+
+        MappedCheckpoint(const MappedCheckpoint&) = delete;
+        MappedCheckpoint& operator=(const MappedCheckpoint&) = delete;
+
+        // false if the file cannot be mapped or is not a checkpoint of this version
+        bool open(const std::string& path);
+        void close();
+
+        bool is_open() const { return m_data != nullptr; }
+        const CheckpointHeader& header() const { return *reinterpret_cast<const CheckpointHeader*>(m_data); }
+
+        const f64* section(u32 k) const { return reinterpret_cast<const f64*>(m_data + header().offsets[k]); }
+        const f64* row(u32 k, u32 i) const { return section(k) + (u64)i * header().stride; }
+
+        template<typename Layout>
+        void restore(StructuredMesh& mesh, MarchingState& state, BasicFlowField<Layout>& f) const
+        {
+            const CheckpointHeader& h = header();
+            mesh = StructuredMesh(std::vector<f64>(section(h.X), section(h.X) + h.imax),
+                                  std::vector<f64>(section(h.Y), section(h.Y) + h.jmax));
+            state.station = h.station;
+            state.nu = h.nu;
+            state.Ue.assign(section(h.Ue), section(h.Ue) + h.imax);
+            state.del1.assign(section(h.Del1), section(h.Del1) + h.imax);
+
+            if (f.imax != h.imax || f.jmax != h.jmax)
+                f = BasicFlowField<Layout>(h.imax, h.jmax);
+            for (u32 i = 0; i < h.imax; i++)
+            {
+                for (u32 j = 0; j < h.jmax; j++)
+                {
+                    f.position(i, j) = Vec2(row(h.PositionX, i)[j], row(h.PositionY, i)[j]);
+                    f.velocity(i, j) = Vec2(row(h.VelocityX, i)[j], row(h.VelocityY, i)[j]);
+                    f.pressure(i, j)  = row(h.Pressure, i)[j];
+                    f.density(i, j)   = row(h.Density, i)[j];
+                    f.viscosity(i, j) = row(h.Viscosity, i)[j];
+                }
+            }
+        }
+
+    private:
+        const u8* m_data = nullptr;
+        u64 m_size = 0;
+#ifdef LW_PLATFORM_WINDOWS
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+}
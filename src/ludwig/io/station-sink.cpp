@@ -0,0 +1,130 @@
+#include "station-sink.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace ludwig::io
+{
+    BinaryStationSink::BinaryStationSink(const std::string& path, const std::vector<f64>& y, u32 stations_per_block)
+        : m_block(std::max(stations_per_block, 1u))
+    {
+        m_header.jmax = u32(y.size());
+        m_buffer.resize((u64)m_block * ( 1 + 2 * (u64)m_header.jmax ));
+
+        m_file = std::fopen(path.c_str(), "wb");
+        m_ok = m_file && std::fwrite(&m_header, sizeof(m_header), 1, m_file) == 1
+                      && std::fwrite(y.data(), sizeof(f64), y.size(), m_file) == y.size();
+    }
+
+    void BinaryStationSink::operator()(u32 i, f64 x, const f64* u, const f64* v)
+    {
+        u32 jmax = m_header.jmax;
+        (*this)(i, core::StationView<const f64>{ x, { u, jmax }, { v, jmax } });
+    }
+
+    void BinaryStationSink::operator()(u32, const core::StationView<const f64>& s)
+    {
+        u32 jmax = m_header.jmax;
+        f64* record = m_buffer.data() + (u64)m_buffered * ( 1 + 2 * (u64)jmax );
+        record[0] = s.x;
+        s.u.copy_to(record + 1);
+        s.v.copy_to(record + 1 + jmax);
+        m_header.stations++;
+
+        if (++m_buffered == m_block)
+            m_ok = write_block() && m_ok;
+    }
+
+    bool BinaryStationSink::write_block()
+    {
+        u64 values = (u64)m_buffered * ( 1 + 2 * (u64)m_header.jmax );
+        m_buffered = 0;
+        return m_file && std::fwrite(m_buffer.data(), sizeof(f64), values, m_file) == values;
+    }
+
+    bool BinaryStationSink::close()
+    {
+        if (!m_file)
+            return m_ok;
+
+        m_ok = write_block() && m_ok;
+        m_ok = std::fseek(m_file, 0, SEEK_SET) == 0 && std::fwrite(&m_header, sizeof(m_header), 1, m_file) == 1 && m_ok;
+        m_ok = std::fclose(m_file) == 0 && m_ok;
+        m_file = nullptr;
+        return m_ok;
+    }
+
+    CgnsStationSink::CgnsStationSink(const std::string& prefix, const std::vector<f64>& y, u32 stations_per_file,
+                                     f64 density, f64 viscosity)
+        : m_prefix(prefix), m_y(y), m_chunk(std::max(stations_per_file, 2u), u32(y.size())), m_density(density), m_viscosity(viscosity)
+    {
+    }
+
+    void CgnsStationSink::operator()(u32 i, f64 x, const f64* u, const f64* v)
+    {
+        u32 jmax = m_chunk.jmax;
+        (*this)(i, core::StationView<const f64>{ x, { u, jmax }, { v, jmax } });
+    }
+
+    void CgnsStationSink::operator()(u32, const core::StationView<const f64>& s)
+    {
+        u32 i = m_filled++;
+        f64* px = m_chunk.position.x.row(i);
+        f64* py = m_chunk.position.y.row(i);
+        std::fill_n(px, m_chunk.jmax, s.x);
+        std::copy(m_y.begin(), m_y.end(), py);
+        s.u.copy_to(m_chunk.velocity.x.row(i));
+        s.v.copy_to(m_chunk.velocity.y.row(i));
+        std::fill_n(m_chunk.density.row(i), m_chunk.jmax, m_density);
+        std::fill_n(m_chunk.viscosity.row(i), m_chunk.jmax, m_viscosity);
+
+        if (m_filled == m_chunk.imax)
+        {
+            submit(m_filled);
+            // overlap the last station so consecutive zones share a boundary
+            u32 last = m_chunk.imax - 1;
+            for (ScalarPlane* p : { &m_chunk.position.x, &m_chunk.position.y, &m_chunk.velocity.x, &m_chunk.velocity.y,
+                                    &m_chunk.pressure, &m_chunk.density, &m_chunk.viscosity })
+                std::copy(p->row(last), p->row(last) + m_chunk.jmax, p->row(0));
+            m_filled = 1;
+        }
+    }
+
+    void CgnsStationSink::submit(u32 stations)
+    {
+        char name[16];
+        std::snprintf(name, sizeof(name), "-%06u.cgns", m_files++);
+        m_writer.write(m_chunk, m_prefix + name, stations);
+    }
+
+    bool CgnsStationSink::close()
+    {
+        // a zone needs two stations, a single overlap station is already in the previous file
+        if (m_filled > 1)
+            submit(m_filled);
+        m_filled = 0;
+        return m_writer.flush();
+    }
+
+    ReducedStationSink::ReducedStationSink(const std::vector<f64>& y, u64 expected_stations)
+        : m_h1(y[1] - y[0]), m_h2(y[2] - y[1]), m_jmax(u32(y.size()))
+    {
+        x.reserve(expected_stations);
+        Ue.reserve(expected_stations);
+        dudy_wall.reserve(expected_stations);
+    }
+
+    void ReducedStationSink::operator()(u32 i, f64 xi, const f64* u, const f64* v)
+    {
+        (*this)(i, core::StationView<const f64>{ xi, { u, m_jmax }, { v, m_jmax } });
+    }
+
+    void ReducedStationSink::operator()(u32, const core::StationView<const f64>& s)
+    {
+        const core::ArrayView<const f64>& u = s.u;
+        f64 h1 = m_h1, h2 = m_h2;
+        x.push_back(s.x);
+        Ue.push_back(u[m_jmax-1]);
+        dudy_wall.push_back(( u[1] * (h1+h2) * (h1+h2) - u[2] * h1 * h1 - u[0] * ( (h1+h2) * (h1+h2) - h1 * h1 ) ) / ( h1 * h2 * (h1+h2) ));
+    }
+}
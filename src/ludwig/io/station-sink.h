@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "vk/vk.h"
+#include "ludwig/core/view.h"
+#include "ludwig/flow/flowfield.h"
+#include "cgns.h"
+
+// Consumers of BoundaryLayerSolver::solve_streaming. Each sink is callable as a
+// StationCallback, pass it by reference: solver.solve_streaming(..., std::ref(sink)).
+// The file sinks hold one buffer of profiles whatever the number of stations; the reduced
+// sink keeps no profiles but grows by a few numbers per station.
+// Every sink also takes a StationView, so a station of a Matrix or a strided line of an
+// Array3 goes straight into its buffer without a gather.
+namespace ludwig::io
+{
+    // Appends stations to one binary file: a header, the jmax wall-normal positions, then a
+    // record { x, u[jmax], v[jmax] } per station. Records are buffered and written in blocks.
+    class BinaryStationSink
+    {
+    public:
+        struct Header
+        {
+            char magic[8] = { 'L', 'W', 'S', 'T', 'R', 'M', '\0', '\0' };
+            u32 version  = 1;
+            u32 jmax     = 0;
+            u64 stations = 0; // patched by close()
+        };
+
+        BinaryStationSink(const std::string& path, const std::vector<f64>& y, u32 stations_per_block = 256);
+        ~BinaryStationSink() { close(); }
+
+        BinaryStationSink(const BinaryStationSink&) = delete;
+        BinaryStationSink& operator=(const BinaryStationSink&) = delete;
+
+        void operator()(u32 i, f64 x, const f64* u, const f64* v);
+        void operator()(u32 i, const core::StationView<const f64>& s);
+
+        // write the buffered records and the final header, false if any write failed
+        bool close();
+
+        u64 stations() const { return m_header.stations; }
+
+    private:
+        bool write_block();
+
+    private:
+        FILE* m_file = nullptr;
+        Header m_header;
+        u32 m_block = 0;           // records per block
+        u32 m_buffered = 0;
+        std::vector<f64> m_buffer; // m_block records
+        bool m_ok = false;
+    };
+
+    // Gathers stations into chunks of a FlowFieldSoA and hands every full chunk to a CgnsWriter,
+    // one structured zone file per chunk: prefix-000000.cgns, prefix-000001.cgns, ...
+    // The writer's double buffering keeps the march running while a chunk goes to disk.
+    class CgnsStationSink
+    {
+    public:
+        CgnsStationSink(const std::string& prefix, const std::vector<f64>& y, u32 stations_per_file = 4096,
+                        f64 density = 1.0, f64 viscosity = 0.0);
+        ~CgnsStationSink() { close(); }
+
+        CgnsStationSink(const CgnsStationSink&) = delete;
+        CgnsStationSink& operator=(const CgnsStationSink&) = delete;
+
+        void operator()(u32 i, f64 x, const f64* u, const f64* v);
+        void operator()(u32 i, const core::StationView<const f64>& s);
+
+        // write the partial last chunk and wait for the writer, false if any file failed
+        bool close();
+
+        u32 files() const { return m_files; }
+
+    private:
+        void submit(u32 stations);
+
+    private:
+        std::string m_prefix;
+        std::vector<f64> m_y;
+        FlowFieldSoA m_chunk;
+        f64 m_density;
+        f64 m_viscosity;
+        u32 m_filled = 0;
+        u32 m_files = 0;
+        CgnsWriter m_writer;
+    };
+
+    // Keeps a few numbers per station instead of the profiles: position, edge velocity and
+    // the wall gradient du/dy (second-order one-sided on the first two cells).
+    class ReducedStationSink
+    {
+    public:
+        explicit ReducedStationSink(const std::vector<f64>& y, u64 expected_stations = 0);
+
+        void operator()(u32 i, f64 x, const f64* u, const f64* v);
+        void operator()(u32 i, const core::StationView<const f64>& s);
+
+        std::vector<f64> x;
+        std::vector<f64> Ue;
+        std::vector<f64> dudy_wall;
+
+    private:
+        f64 m_h1 = 0.0;
+        f64 m_h2 = 0.0;
+        u32 m_jmax = 0;
+    };
+}
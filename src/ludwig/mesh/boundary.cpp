@@ -0,0 +1,27 @@
+#include "boundary.h"
+
+namespace ludwig
+{
+    BoundaryNodes::BoundaryNodes(const BoundarySpec& spec, u32 nj) : jmax(nj)
+    {
+        // nothing to classify without interior nodes (and before a solver is sized)
+        if (jmax < 3)
+            return;
+
+        auto mark = [&](u32 j, Side side, u32 in) {
+            BoundarySet& set = sets[(u32)spec[side]];
+            set.nodes.push_back(j);
+            set.neighbours.push_back(in);
+        };
+        mark(0, Side::Wall, 1);
+        mark(jmax-1, Side::Edge, jmax-2);
+    }
+
+    u32 BoundaryNodes::size() const
+    {
+        u32 n = 0;
+        for (const BoundarySet& s : sets)
+            n += s.size();
+        return n;
+    }
+}
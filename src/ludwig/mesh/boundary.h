@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "vk/vk.h"
+
+namespace ludwig
+{
+    enum class BoundaryType : u8
+    {
+        Wall = 0,
+        Inlet,
+        Outlet,
+        Symmetry,
+        Count
+    };
+
+    // the wall-normal sides of a marching station; the inflow and outflow are not boundary
+    // conditions of a march, the inflow profile is given and the last station is computed
+    enum class Side : u8
+    {
+        Wall = 0, // j = 0
+        Edge,     // j = jmax-1, the outer edge of the boundary layer
+        Count
+    };
+
+    // BoundaryType of every side. Wall: no slip, u = 0. Inlet: u prescribed, the edge velocity.
+    // Symmetry and Outlet: zero normal gradient, u copied from the node next to the boundary.
+    // The defaults are the flat plate.
+    struct BoundarySpec
+    {
+        std::array<BoundaryType, (u32)Side::Count> sides = { BoundaryType::Wall, BoundaryType::Inlet };
+
+        BoundaryType& operator[](Side s) { return sides[(u32)s]; }
+        BoundaryType operator[](Side s) const { return sides[(u32)s]; }
+    };
+
+    // true for the types that copy their neighbour instead of holding a value
+    inline bool zero_gradient(BoundaryType t) { return t == BoundaryType::Symmetry || t == BoundaryType::Outlet; }
+
+    // the nodes of one BoundaryType as indices j into a station profile
+    struct BoundarySet
+    {
+        std::vector<u32> nodes;
+        std::vector<u32> neighbours; // the node next to each one, one step into the mesh normal to its side
+
+        u32 size() const { return (u32)nodes.size(); }
+    };
+
+    // The wall and edge nodes of a station, j = 0 and jmax-1, classified by BoundaryType once at
+    // setup, so the solvers apply each condition as a short pass over a compact index list and
+    // keep their interior loops (j = 1..jmax-2) free of boundary tests.
+    struct BoundaryNodes
+    {
+        u32 jmax = 0;
+        std::array<BoundarySet, (u32)BoundaryType::Count> sets;
+
+        BoundaryNodes() = default;
+        BoundaryNodes(const BoundarySpec& spec, u32 jmax);
+
+        const BoundarySet& operator[](BoundaryType t) const { return sets[(u32)t]; }
+        u32 size() const;
+    };
+
+    // u[node] = value on every node of the set
+    template<typename T>
+    void apply_value(const BoundarySet& s, T* u, const T& value)
+    {
+        for (u32 n : s.nodes)
+            u[n] = value;
+    }
+
+    // u[node] = u[neighbour], a zero normal gradient to first order
+    template<typename T>
+    void apply_zero_gradient(const BoundarySet& s, T* u)
+    {
+        for (u32 k = 0; k < s.size(); k++)
+            u[s.nodes[k]] = u[s.neighbours[k]];
+    }
+}
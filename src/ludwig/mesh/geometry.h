@@ -2,6 +2,7 @@
 
 #include "vk/vk.h"
 #include "uniform-grid.h"
+#include "boundary.h"
 
 namespace ludwig
 {
@@ -35,13 +36,6 @@ namespace ludwig
 
     
          
-    enum class BoundaryType : u8
-    {
-        Wall = 0,
-        Inlet, 
-        Outlet, 
-        Symmetry,
-    };
     struct Boundary
     {
         Vector<Vec3> vertexes;
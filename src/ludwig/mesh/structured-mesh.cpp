@@ -0,0 +1,159 @@
+#include "structured-mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "uniform-grid.h"
+
+namespace ludwig
+{
+    void WallNormalMetrics::resize(u32 jmax)
+    {
+        dy.assign(jmax-1, 0.0);
+        d1.assign(jmax, 0.0);
+        d2_lower.assign(jmax, 0.0);
+        d2_upper.assign(jmax, 0.0);
+        quadrature.assign(jmax, 0.0);
+    }
+
+    void WallNormalMetrics::compute(const std::vector<f64>& y)
+    {
+        const u32 n = (u32)y.size();
+        resize(n);
+
+        for (u32 j = 0; j < n-1; j++)
+            dy[j] = y[j+1] - y[j];
+
+        for (u32 j = 1; j < n-1; j++)
+        {
+            f64 hm = dy[j-1];
+            f64 hp = dy[j];
+            f64 s  = hm + hp;
+            d1[j]       = 1.0 / s;
+            d2_lower[j] = 2.0 / ( hm * s );
+            d2_upper[j] = 2.0 / ( hp * s );
+        }
+
+        // Simpson on pairs of unequal intervals, a last odd interval from the quadratic through
+        // its three closest nodes, so the rule stays exact for quadratics
+        std::fill(quadrature.begin(), quadrature.end(), 0.0);
+        u32 j = 0;
+        for (; j + 2 < n; j += 2)
+        {
+            f64 h0 = dy[j];
+            f64 h1 = dy[j+1];
+            f64 c  = ( h0 + h1 ) / 6.0;
+            quadrature[j]   += c * ( 2.0 - h1 / h0 );
+            quadrature[j+1] += c * ( h0 + h1 ) * ( h0 + h1 ) / ( h0 * h1 );
+            quadrature[j+2] += c * ( 2.0 - h0 / h1 );
+        }
+        if (j + 1 < n && j > 0)
+        {
+            f64 a = dy[j-1];
+            f64 b = dy[j];
+            quadrature[j-1] -= b * b * b / ( 6.0 * a * ( a + b ) );
+            quadrature[j]   += b * ( 3.0*a + b ) / ( 6.0 * a );
+            quadrature[j+1] += b * ( 3.0*a + 2.0*b ) / ( 6.0 * ( a + b ) );
+        }
+        else if (j + 1 < n)
+        {
+            quadrature[j]   += 0.5 * dy[j];
+            quadrature[j+1] += 0.5 * dy[j];
+        }
+
+        if (n > 2)
+        {
+            f64 h1 = dy[0];
+            f64 h2 = dy[1];
+            wall_gradient[0] = -( 2.0*h1 + h2 ) / ( h1 * ( h1 + h2 ) );
+            wall_gradient[1] = ( h1 + h2 ) / ( h1 * h2 );
+            wall_gradient[2] = -h1 / ( h2 * ( h1 + h2 ) );
+        }
+    }
+
+    std::vector<f64> wall_distribution(f64 H, u32 n, Clustering clustering, f64 stretching)
+    {
+        switch (clustering)
+        {
+            case Clustering::Geometric:
+                return inflation_layer(H, n, stretching);
+
+            case Clustering::Tanh:
+            {
+                std::vector<f64> y(n, 0.0);
+                const f64 t = std::tanh(stretching);
+                for (u32 j = 0; j < n; j++)
+                {
+                    f64 eta = (f64)j / (n - 1);
+                    y[j] = H * ( 1.0 - std::tanh(stretching * (1.0 - eta)) / t );
+                }
+                y[0]   = 0.0;
+                y[n-1] = H;
+                return y;
+            }
+
+            case Clustering::Uniform:
+            default:
+            {
+                std::vector<f64> y(n, 0.0);
+                for (u32 j = 0; j < n; j++)
+                    y[j] = H * j / (n - 1);
+                return y;
+            }
+        }
+    }
+
+    f64 geometric_ratio(f64 H, u32 n, f64 dy0)
+    {
+        // H / dy0 = (g^(n-1) - 1) / (g - 1) grows monotonically with g, bisect on it
+        const f64 target = H / dy0;
+        if (target <= n - 1)
+            return 1.0;
+
+        auto cells = [&](f64 g)
+        {
+            f64 sum = 0.0;
+            f64 gj  = 1.0;
+            for (u32 j = 0; j < n-1; j++)
+            {
+                sum += gj;
+                gj  *= g;
+            }
+            return sum;
+        };
+
+        f64 lo = 1.0;
+        f64 hi = 2.0;
+        while (cells(hi) < target)
+            hi *= 2.0;
+        for (u32 it = 0; it < 100; it++)
+        {
+            f64 mid = 0.5 * (lo + hi);
+            if (cells(mid) < target)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        return 0.5 * (lo + hi);
+    }
+
+    StructuredMesh::StructuredMesh(const MeshSpec& spec)
+        : imax(spec.imax), jmax(spec.jmax), x(spec.imax)
+    {
+        for (u32 i = 0; i < imax; i++)
+            x[i] = spec.x0 + (spec.x1 - spec.x0) * i / (imax - 1);
+
+        y = wall_distribution(spec.y1 - spec.y0, jmax, spec.clustering, spec.stretching);
+        for (u32 j = 0; j < jmax; j++)
+            y[j] += spec.y0;
+
+        metrics.compute(y);
+    }
+
+    StructuredMesh::StructuredMesh(std::vector<f64> xs, std::vector<f64> ys)
+        : imax(u32(xs.size())), jmax(u32(ys.size())), x(std::move(xs)), y(std::move(ys))
+    {
+        metrics.compute(y);
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "vk/vk.h"
+
+namespace ludwig
+{
+    enum class Clustering : u8
+    {
+        Uniform = 0,
+        Geometric,  // dy grows by a constant ratio away from the wall (inflation layer)
+        Tanh,       // hyperbolic tangent, smooth spacing with the finest cells at the wall
+    };
+
+    // rectangular marching domain, x streamwise and y wall-normal with the wall at y0
+    struct MeshSpec
+    {
+        f64 x0 = 0.0;
+        f64 x1 = 1.0;
+        f64 y0 = 0.0;
+        f64 y1 = 1.0;
+        u32 imax = 2;
+        u32 jmax = 3;
+        Clustering clustering = Clustering::Uniform;
+        f64 stretching = 1.0; // growth ratio (Geometric) or beta (Tanh)
+    };
+
+    // Wall-normal finite-difference coefficients, computed once per mesh so the solver loops do
+    // no divisions or index arithmetic for spacing. Node j sees dy[j-1] below and dy[j] above,
+    // the arrays are indexed by node and only valid on the interior nodes 1..jmax-2 (dy excepted).
+    // On a uniform mesh d2_lower = d2_upper = 1/dy^2.
+    struct WallNormalMetrics
+    {
+        std::vector<f64> dy;        // y[j+1] - y[j], jmax-1 entries
+        std::vector<f64> d1;        // 1 / (dy[j-1] + dy[j]), central first derivative
+        std::vector<f64> d2_lower;  // 2 / (dy[j-1] (dy[j-1] + dy[j])), second derivative weight of j-1
+        std::vector<f64> d2_upper;  // 2 / (dy[j]   (dy[j-1] + dy[j])), second derivative weight of j+1
+        std::vector<f64> quadrature; // integral over [y0, y(jmax-1)] = sum quadrature[j] f[j], all nodes
+        std::array<f64, 3> wall_gradient = {}; // df/dy at the wall from nodes 0, 1, 2, second order
+
+        void resize(u32 jmax);
+
+        // allocation free once the arrays have been sized for y
+        void compute(const std::vector<f64>& y);
+    };
+
+    struct StructuredMesh
+    {
+        u32 imax = 0;
+        u32 jmax = 0;
+        std::vector<f64> x; // station positions
+        std::vector<f64> y; // wall-normal node positions, shared by every station
+        WallNormalMetrics metrics;
+
+        StructuredMesh() = default;
+        StructuredMesh(const MeshSpec& spec);
+        StructuredMesh(std::vector<f64> x, std::vector<f64> y); // explicit node positions
+    };
+
+    // wall-normal distribution of n nodes over [0, H] for the given clustering
+    std::vector<f64> wall_distribution(f64 H, u32 n, Clustering clustering, f64 stretching);
+
+    // growth ratio of a geometric distribution of n nodes over H whose first cell is dy0
+    f64 geometric_ratio(f64 H, u32 n, f64 dy0);
+}
@@ -2,6 +2,7 @@
 
 #include <stdint.h> 
 #include <math.h>
+#include <cmath>
 #include <vector>
 
 #include "vk/vk.h"
@@ -9,16 +10,26 @@ namespace ludwig
 {
 
 
-    // this doesnt work yet
+    // N wall-normal node positions from 0 to H whose spacing grows by the ratio g away from the
+    // wall: dy[j] = dy[0] g^j
     static std::vector<f64> inflation_layer(f64 H, uint32_t N, f64 g)
     {
-        
         std::vector<f64> y(N, 0);
-        
-        y[1] = H * (1 - g) / ( 1 - pow(g, N+1));
-
-        for (int i=2; i < N; i++)
-            y[i] = y[1] * pow(g, i-1);
+        if (N < 2)
+            return y;
+
+        // first cell from the geometric sum H = dy0 (g^(N-1) - 1) / (g - 1)
+        f64 gn = 1.0;
+        for (uint32_t j = 1; j < N; j++)
+            gn *= g;
+        f64 dy = ( std::abs(g - 1.0) < 1e-12 ) ? H / (N - 1) : H * (g - 1.0) / (gn - 1.0);
+
+        for (uint32_t j = 1; j < N; j++)
+        {
+            y[j] = y[j-1] + dy;
+            dy *= g;
+        }
+        y[N-1] = H;
 
         return y;
     }
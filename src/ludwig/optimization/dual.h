@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <utility>
+
+#include "vk/vk.h"
+
+namespace ludwig::optimize
+{
+    // Forward-mode automatic differentiation: a value and its derivatives with respect to N
+    // parameters, carried through every arithmetic operation. Code templated on the scalar type
+    // runs on Dual<N> unchanged and returns the full gradient with its result in one pass.
+    // Comparisons look at the value only, so branches pick the active piece of piecewise code.
+    // f(0), f(1), ..., f(N-1) expanded at compile time, the derivative loops are too short for
+    // the optimizer to unroll them at -O2
+    template<u32 N, typename F>
+    inline void unrolled(F&& f)
+    {
+        [&]<u32... K>(std::integer_sequence<u32, K...>) { ( f(K), ... ); }(std::make_integer_sequence<u32, N>{});
+    }
+
+    template<u32 N>
+    struct Dual
+    {
+        f64 value = 0.0;
+        std::array<f64, N> grad = {};
+
+        Dual() = default;
+        Dual(f64 v) : value(v) {}
+
+        // the independent variable `index`, seeded with d/dp(index) = 1
+        static Dual variable(f64 v, u32 index)
+        {
+            Dual d(v);
+            d.grad[index] = 1.0;
+            return d;
+        }
+
+        Dual& operator+=(const Dual& b) { value += b.value; unrolled<N>([&](u32 k) { grad[k] += b.grad[k]; }); return *this; }
+        Dual& operator-=(const Dual& b) { value -= b.value; unrolled<N>([&](u32 k) { grad[k] -= b.grad[k]; }); return *this; }
+        Dual& operator*=(const Dual& b)
+        {
+            unrolled<N>([&](u32 k) { grad[k] = grad[k] * b.value + value * b.grad[k]; });
+            value *= b.value;
+            return *this;
+        }
+        Dual& operator/=(const Dual& b)
+        {
+            f64 r = 1.0 / b.value;
+            value *= r;
+            unrolled<N>([&](u32 k) { grad[k] = ( grad[k] - value * b.grad[k] ) * r; });
+            return *this;
+        }
+
+        Dual& operator+=(f64 b) { value += b; return *this; }
+        Dual& operator-=(f64 b) { value -= b; return *this; }
+        Dual& operator*=(f64 b) { value *= b; unrolled<N>([&](u32 k) { grad[k] *= b; }); return *this; }
+        Dual& operator/=(f64 b) { return *this *= 1.0 / b; }
+
+        Dual operator-() const
+        {
+            Dual d;
+            d.value = -value;
+            unrolled<N>([&](u32 k) { d.grad[k] = -grad[k]; });
+            return d;
+        }
+    };
+
+    template<u32 N> inline Dual<N> operator+(Dual<N> a, const Dual<N>& b) { return a += b; }
+    template<u32 N> inline Dual<N> operator-(Dual<N> a, const Dual<N>& b) { return a -= b; }
+    template<u32 N> inline Dual<N> operator*(Dual<N> a, const Dual<N>& b) { return a *= b; }
+    template<u32 N> inline Dual<N> operator/(Dual<N> a, const Dual<N>& b) { return a /= b; }
+
+    template<u32 N> inline Dual<N> operator+(Dual<N> a, f64 b) { return a += b; }
+    template<u32 N> inline Dual<N> operator-(Dual<N> a, f64 b) { return a -= b; }
+    template<u32 N> inline Dual<N> operator*(Dual<N> a, f64 b) { return a *= b; }
+    template<u32 N> inline Dual<N> operator/(Dual<N> a, f64 b) { return a /= b; }
+
+    template<u32 N> inline Dual<N> operator+(f64 a, Dual<N> b) { return b += a; }
+    template<u32 N> inline Dual<N> operator-(f64 a, const Dual<N>& b) { return Dual<N>(a) -= b; }
+    template<u32 N> inline Dual<N> operator*(f64 a, Dual<N> b) { return b *= a; }
+    template<u32 N> inline Dual<N> operator/(f64 a, const Dual<N>& b) { return Dual<N>(a) /= b; }
+
+    template<u32 N> inline bool operator<(const Dual<N>& a, const Dual<N>& b)  { return a.value < b.value; }
+    template<u32 N> inline bool operator>(const Dual<N>& a, const Dual<N>& b)  { return a.value > b.value; }
+    template<u32 N> inline bool operator<=(const Dual<N>& a, const Dual<N>& b) { return a.value <= b.value; }
+    template<u32 N> inline bool operator>=(const Dual<N>& a, const Dual<N>& b) { return a.value >= b.value; }
+    template<u32 N> inline bool operator<(const Dual<N>& a, f64 b)  { return a.value < b; }
+    template<u32 N> inline bool operator>(const Dual<N>& a, f64 b)  { return a.value > b; }
+    template<u32 N> inline bool operator<=(const Dual<N>& a, f64 b) { return a.value <= b; }
+    template<u32 N> inline bool operator>=(const Dual<N>& a, f64 b) { return a.value >= b; }
+    template<u32 N> inline bool operator<(f64 a, const Dual<N>& b)  { return a < b.value; }
+    template<u32 N> inline bool operator>(f64 a, const Dual<N>& b)  { return a > b.value; }
+    template<u32 N> inline bool operator<=(f64 a, const Dual<N>& b) { return a <= b.value; }
+    template<u32 N> inline bool operator>=(f64 a, const Dual<N>& b) { return a >= b.value; }
+
+    // chain rule for f(a) with derivative df at a.value
+    template<u32 N>
+    inline Dual<N> chain(const Dual<N>& a, f64 f, f64 df)
+    {
+        Dual<N> d(f);
+        unrolled<N>([&](u32 k) { d.grad[k] = df * a.grad[k]; });
+        return d;
+    }
+
+    template<u32 N> inline Dual<N> sqrt(const Dual<N>& a) { f64 s = std::sqrt(a.value); return chain(a, s, 0.5 / s); }
+    template<u32 N> inline Dual<N> exp(const Dual<N>& a)  { f64 e = std::exp(a.value); return chain(a, e, e); }
+    template<u32 N> inline Dual<N> log(const Dual<N>& a)  { return chain(a, std::log(a.value), 1.0 / a.value); }
+    template<u32 N> inline Dual<N> abs(const Dual<N>& a)  { return a.value < 0.0 ? -a : a; }
+    template<u32 N> inline Dual<N> pow(const Dual<N>& a, f64 p)
+    {
+        f64 v = std::pow(a.value, p);
+        return chain(a, v, p * std::pow(a.value, p - 1.0));
+    }
+
+    inline f64 value(f64 a) { return a; }
+    template<u32 N> inline f64 value(const Dual<N>& a) { return a.value; }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "vk/vk.h"
+#include "dual.h"
+
+namespace ludwig::optimize
+{
+    struct GradientDescentSettings
+    {
+        u32 max_iterations = 100;
+        f64 step           = 1.0;   // first trial step along -gradient
+        f64 shrink         = 0.5;   // backtracking factor
+        f64 armijo         = 1e-4;  // sufficient decrease, J(p - t g) <= J(p) - armijo t |g|^2
+        u32 max_backtracks = 30;
+        f64 tolerance      = 1e-8;  // stop once |g| falls below
+    };
+
+    template<u32 N>
+    struct OptimizationResult
+    {
+        std::array<f64, N> parameters = {};
+        std::array<f64, N> gradient   = {};
+        f64 cost        = 0.0;
+        f64 initial     = 0.0;  // cost at the starting point
+        u32 iterations  = 0;
+        u32 evaluations = 0;    // cost evaluations, gradients included
+        bool converged  = false;
+    };
+
+    // cost and gradient from one evaluation on dual numbers. The cost is any callable templated
+    // on the scalar type, cost(const std::array<T, N>&) -> T.
+    template<u32 N, typename Cost>
+    Dual<N> evaluate_gradient(const Cost& cost, const std::array<f64, N>& p)
+    {
+        std::array<Dual<N>, N> d;
+        for (u32 k = 0; k < N; k++)
+            d[k] = Dual<N>::variable(p[k], k);
+        return cost(d);
+    }
+
+    // Steepest descent with a backtracking (Armijo) line search. Every iteration costs one dual
+    // evaluation for the gradient, where central differences would need 2N marches of the
+    // plain cost, plus the f64 evaluations of the line search. A trial point whose cost is not
+    // finite (the march separated, the inflow degenerated) is treated as too long a step.
+    template<u32 N, typename Cost>
+    OptimizationResult<N> gradient_descent(std::array<f64, N> p, const Cost& cost, const GradientDescentSettings& settings = {})
+    {
+        OptimizationResult<N> result;
+        Dual<N> J = evaluate_gradient<N>(cost, p);
+        result.initial = J.value;
+        result.evaluations = 1;
+
+        f64 step = settings.step;
+        for (u32 it = 0; it < settings.max_iterations; it++)
+        {
+            f64 g2 = 0.0;
+            for (u32 k = 0; k < N; k++)
+                g2 += J.grad[k] * J.grad[k];
+            if (std::sqrt(g2) < settings.tolerance)
+            {
+                result.converged = true;
+                break;
+            }
+
+            bool accepted = false;
+            std::array<f64, N> trial;
+            for (u32 b = 0; b < settings.max_backtracks; b++)
+            {
+                for (u32 k = 0; k < N; k++)
+                    trial[k] = p[k] - step * J.grad[k];
+                f64 f = cost(trial);
+                result.evaluations++;
+                if (std::isfinite(f) && f <= J.value - settings.armijo * step * g2)
+                {
+                    accepted = true;
+                    break;
+                }
+                step *= settings.shrink;
+            }
+            if (!accepted)
+                break;
+
+            p = trial;
+            J = evaluate_gradient<N>(cost, p);
+            result.evaluations++;
+            result.iterations++;
+            // let the next line search try a longer step again
+            step = std::min(settings.step, step / settings.shrink);
+        }
+
+        result.parameters = p;
+        result.cost = J.value;
+        result.gradient = J.grad;
+        return result;
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "vk/vk.h"
+#include "dual.h"
+#include "ludwig/flow/case.h"
+#include "ludwig/mesh/structured-mesh.h"
+#include "ludwig/solver/marching.h"
+
+namespace ludwig::optimize
+{
+    // Laminar pressure recovery over the mesh's x range. The parameters shape the edge velocity
+    // and the inflow:
+    //   Ue = U0 ( 1 - p0 xi - p1 xi^2 ),  xi = (x - x0) / (x1 - x0)
+    //   inflow thickness = p2 * c.thickness(x)
+    // and the cost trades the recovery against skin-friction drag and separation:
+    //   J = -recovery Cp(x1) + drag mean(cf) / cf_ref + separation mean( max(0, 1 - cf / cf_min)^2 )
+    // with Cp(x1) = 1 - (Ue(x1) / U0)^2 and cf_ref the flat-plate value at x1. The separation
+    // term is a smooth stand-in for the separation location: it grows as soon as cf drops
+    // towards cf_min anywhere, before the march itself breaks down.
+    struct RecoveryDesign
+    {
+        static constexpr u32 parameters = 3;
+
+        BoundaryLayerCase c;
+        StructuredMesh mesh;
+        f64 recovery   = 1.0;
+        f64 drag       = 0.0;
+        f64 separation = 10.0;
+        f64 cf_min     = 3e-3;
+
+        RecoveryDesign(const BoundaryLayerCase& c_, const StructuredMesh& mesh_) : c(c_), mesh(mesh_) {}
+
+        template<typename T>
+        T edge_velocity(const std::array<T, parameters>& p, f64 x) const
+        {
+            f64 xi = ( x - mesh.x.front() ) / ( mesh.x.back() - mesh.x.front() );
+            return c.U0 * ( 1.0 - p[0] * xi - p[1] * xi * xi );
+        }
+
+        // one march with the Implicit scheme, scalar T throughout
+        template<typename T>
+        T operator()(const std::array<T, parameters>& p) const
+        {
+            const u32 imax = mesh.imax;
+            const u32 jmax = mesh.jmax;
+            const f64 nu   = c.nu();
+            const std::vector<f64>& x = mesh.x;
+
+            std::vector<T> u0(jmax), v0(jmax), u1(jmax), v1(jmax);
+            solve::MarchingKernel<T> kernel(jmax);
+
+            T Ue0 = edge_velocity(p, x[0]);
+            T Ue1 = edge_velocity(p, x[1]);
+            inflow_profile(mesh.y, Ue0, Ue1, T(p[2] * c.thickness(x[0])), T(p[2] * c.thickness(x[1])), x[1] - x[0], u0.data(), v0.data());
+
+            const f64 cf_ref = 0.664 / std::sqrt(c.U0 * x[imax-1] / nu);
+            T friction = T(0);
+            T penalty  = T(0);
+            for (u32 i = 1; i < imax; i++)
+            {
+                Ue1 = edge_velocity(p, x[i]);
+                kernel.advance(mesh.metrics, x[i] - x[i-1], Ue0, Ue1, nu, u0.data(), v0.data(), u1.data(), v1.data());
+                std::swap(u0, u1);
+                std::swap(v0, v1);
+                Ue0 = Ue1;
+
+                T cf = solve::skin_friction(u0.data(), Ue0, nu, mesh.metrics);
+                friction += cf;
+                T deficit = 1.0 - cf / cf_min;
+                if (deficit > 0.0)
+                    penalty += deficit * deficit;
+            }
+
+            T q  = Ue0 / c.U0;
+            T cp = 1.0 - q * q;
+            return -recovery * cp + ( drag / cf_ref * friction + separation * penalty ) / f64(imax-1);
+        }
+    };
+}
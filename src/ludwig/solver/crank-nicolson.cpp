@@ -0,0 +1,487 @@
+#include "crank-nicolson.h"
+#include "marching.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "ludwig/core/aligned.h"
+#include "ludwig/core/profile.h"
+
+namespace ludwig::solve
+{
+    BoundaryLayerSolver::BoundaryLayerSolver(u32 imax, u32 jmax, core::Arena* arena)
+    {
+        resize(imax, jmax, arena);
+    }
+
+    u64 BoundaryLayerSolver::arena_bytes(u32 jmax)
+    {
+        // five profiles and the adaptive ring, plus the alignment of the first row
+        return ( 5 + std::tuple_size_v<decltype(m_adaptive)> ) * core::padded_size<f64>(jmax) * sizeof(f64) + core::cache_line;
+    }
+
+    void BoundaryLayerSolver::resize(u32 imax, u32 jmax, core::Arena* arena)
+    {
+        m_imax = imax;
+        m_jmax = jmax;
+
+        m_metrics.resize(jmax);
+        m_A.resize(jmax-2);
+        m_rhs.assign(jmax-2, 0.0);
+        m_workspace.prepare(jmax-2);
+        m_block.resize(jmax-2);
+        m_delta.assign(jmax-2, {});
+        m_block_scratch.assign(jmax-2, {});
+        m_boundaries = BoundaryNodes(m_boundary_spec, jmax);
+
+        // station buffers, back to back in one block
+        if (!arena)
+        {
+            m_arena.reserve(arena_bytes(jmax));
+            arena = &m_arena;
+        }
+        const u64 row = core::padded_size<f64>(jmax);
+        auto carve = [&]() {
+            f64* p = arena->allocate_array<f64>(row);
+            std::fill_n(p, row, 0.0);
+            return p;
+        };
+        m_ubar      = carve();
+        m_vbar      = carve();
+        m_predicted = carve();
+        m_nu_eff    = carve();
+        m_iterate   = carve();
+        for (f64*& buffer : m_adaptive)
+            buffer = carve();
+    }
+
+    void BoundaryLayerSolver::set_boundaries(const BoundarySpec& spec)
+    {
+        m_boundary_spec = spec;
+        m_boundaries = BoundaryNodes(spec, m_jmax);
+    }
+
+    // the metrics are sized for the solver's jmax, a mesh of another height needs resize() first
+    void BoundaryLayerSolver::set_mesh(const std::vector<f64>& y)
+    {
+        assert(y.size() == m_jmax);
+        m_metrics.compute(y);
+    }
+
+    void BoundaryLayerSolver::set_mesh(const StructuredMesh& mesh)
+    {
+        assert(mesh.jmax == m_jmax);
+        m_metrics = mesh.metrics;
+    }
+
+    void BoundaryLayerSolver::solve(const StructuredMesh& mesh, const std::vector<f64>& Ue, f64 nu, Matrix<f64>& u, Matrix<f64>& v)
+    {
+        set_mesh(mesh);
+        march(mesh.x, Ue, nu, u, v);
+    }
+
+    void BoundaryLayerSolver::solve(const std::vector<f64>& x, const std::vector<f64>& y, const std::vector<f64>& Ue, f64 nu,
+                                    Matrix<f64>& u, Matrix<f64>& v)
+    {
+        set_mesh(y);
+        march(x, Ue, nu, u, v);
+    }
+
+    void BoundaryLayerSolver::march(const std::vector<f64>& x, const std::vector<f64>& Ue, f64 nu, Matrix<f64>& u, Matrix<f64>& v)
+    {
+        begin_integrals(m_imax);
+        reduce(x[0], Ue[0], &u(0, 0), nu);
+        for (u32 i = 0; i < m_imax-1; i++)
+        {
+            step(i, x, Ue, nu, u, v);
+            reduce(x[i+1], Ue[i+1], &u(i+1, 0), nu);
+        }
+    }
+
+    void BoundaryLayerSolver::begin_integrals(u64 stations)
+    {
+        if (!m_integrals)
+            return;
+        m_integrals->clear();
+        m_integrals->reserve(stations);
+    }
+
+    void BoundaryLayerSolver::reduce(f64 x, f64 Ue, const f64* u, f64 nu)
+    {
+        if (m_integrals)
+            m_integrals->push(x, integrate_station(u, Ue, nu, m_metrics));
+    }
+
+    // momentum: implicit diffusion, explicit convection, coefficients lagged at station i.
+    // nu_eff (or nullptr for constant nu) is averaged to the half nodes j -+ 1/2.
+    void BoundaryLayerSolver::assemble_implicit(const Station& cur, f64 dx, f64 dUe2, f64 nu, const f64* nu_eff)
+    {
+        LW_PROFILE_ZONE("march/assemble");
+        rows::with_viscosity(nu, nu_eff, [&](auto visc) {
+            rows::implicit_rows(m_jmax, m_metrics, cur.u, cur.v, dx, dUe2, visc, m_A.lower.data(), m_A.diag.data(), m_A.upper.data(), m_rhs.data());
+        });
+    }
+
+    // momentum: theta-weighted diffusion and convection on the non-uniform y stencil,
+    //   u' - theta k L(u') = u + (1 - theta) k L(u) + dUe2 / (2 ubar),   k = dx / ubar
+    //   L(u) = (nu u_y)_y - vbar u_y
+    // with the coefficients ubar, vbar given at x(i) + theta dx and nu as in assemble_implicit
+    void BoundaryLayerSolver::assemble_theta(const Station& cur, const f64* ubar, const f64* vbar, f64 dx, f64 dUe2, f64 nu, const f64* nu_eff)
+    {
+        LW_PROFILE_ZONE("march/assemble");
+        rows::with_viscosity(nu, nu_eff, [&](auto visc) {
+            rows::theta_rows(m_jmax, m_metrics, cur.u, ubar, vbar, m_theta, dx, dUe2, visc, m_A.lower.data(), m_A.diag.data(), m_A.upper.data(), m_rhs.data());
+        });
+    }
+
+    void BoundaryLayerSolver::step(u32 i, const std::vector<f64>& x, const std::vector<f64>& Ue, f64 nu,
+                                   Matrix<f64>& u, Matrix<f64>& v)
+    {
+        Station prev = { i > 0 ? x[i-1] : 0.0, i > 0 ? Ue[i-1] : 0.0, i > 0 ? &u(i-1, 0) : nullptr, i > 0 ? &v(i-1, 0) : nullptr };
+        Station cur  = { x[i],   Ue[i],   &u(i, 0),   &v(i, 0) };
+        Station next = { x[i+1], Ue[i+1], &u(i+1, 0), &v(i+1, 0) };
+        advance(i > 0 ? &prev : nullptr, cur, next, nu);
+    }
+
+    void BoundaryLayerSolver::advance(const Station* prev, const Station& cur, Station& next, f64 nu)
+    {
+        LW_PROFILE_ZONE("march/station");
+        LW_PROFILE_COUNT(Stations, 1);
+        const u32 jmax = m_jmax;
+        const f64 dx   = next.x - cur.x;
+        const f64 dUe2 = next.Ue*next.Ue - cur.Ue*cur.Ue;
+
+        fix_boundaries(next);
+
+        const f64* nu_eff = nullptr;
+        if (m_turbulence.active(cur.x))
+        {
+            LW_PROFILE_ZONE("march/eddy-viscosity");
+            eddy_viscosity(cur.u, cur.Ue, nu, m_metrics, m_turbulence, m_nu_eff);
+            nu_eff = m_nu_eff;
+        }
+
+        const f64 tolerance = m_iteration.tolerance * std::abs(next.Ue);
+        if (m_scheme != MarchingScheme::Theta)
+        {
+            assemble_implicit(cur, dx, dUe2, nu, nu_eff);
+            solve_momentum(next);
+            continuity(nullptr, cur, next);
+            if (m_scheme == MarchingScheme::Implicit)
+                return;
+
+            // the first step off the inflow is backward Euler, which damps the start-up
+            // transient that theta = 0.5 would carry downstream
+            const f64 theta = prev ? m_theta : 1.0;
+            for (u32 pass = 0; pass < m_iteration.max_iterations; pass++)
+            {
+                if (newton_step(cur, next, theta, dx, dUe2, nu, nu_eff) < tolerance)
+                    break;
+            }
+            return;
+        }
+
+        // predictor with the coefficients of station i, then correctors with the coefficients
+        // interpolated to x(i) + theta dx from the latest estimate of station i+1. v comes from
+        // a difference of u in x, so the first corrector still carries an O(dx) error in v and
+        // the second one is needed for second order. With a tolerance the passes stop as soon
+        // as the iterate settles.
+        assemble_theta(cur, cur.u, cur.v, dx, dUe2, nu, nu_eff);
+        solve_momentum(next);
+        continuity(prev, cur, next);
+        std::copy(next.u, next.u + jmax, m_predicted);
+
+        const f64 theta = m_theta;
+        for (u32 pass = 0; pass < m_iteration.max_iterations; pass++)
+        {
+            if (tolerance > 0.0)
+                std::copy(next.u, next.u + jmax, m_iterate);
+
+            for (u32 j = 0; j < jmax; j++)
+            {
+                m_ubar[j] = ( 1.0 - theta ) * cur.u[j] + theta * next.u[j];
+                m_vbar[j] = ( 1.0 - theta ) * cur.v[j] + theta * next.v[j];
+                // near separation the prediction can run negative, fall back to the lagged value
+                if (m_ubar[j] < 0.5 * cur.u[j])
+                    m_ubar[j] = cur.u[j];
+            }
+            assemble_theta(cur, m_ubar, m_vbar, dx, dUe2, nu, nu_eff);
+            solve_momentum(next);
+            continuity(prev, cur, next);
+
+            if (tolerance > 0.0 && change(next.u) < tolerance)
+                break;
+        }
+    }
+
+    f64 BoundaryLayerSolver::change(const f64* u) const
+    {
+        f64 change = 0.0;
+        for (u32 j = 1; j < m_jmax-1; j++)
+            change = std::max(change, std::abs(u[j] - m_iterate[j]));
+        return change;
+    }
+
+    // One Newton update of station i+1 on the theta-weighted momentum and continuity equations,
+    //   M = ubar (u' - u) + theta dx ( v' u'_y - (nu u'_y)_y ) + (1 - theta) dx ( v u_y - (nu u_y)_y ) - dUe2 / 2
+    //   C = theta ( v'(j) - v'(j-1) ) + (1 - theta) ( v(j) - v(j-1) ) + dy / (2 dx) ( u' - u )(j-1, j)
+    // with ubar = (1 - theta) u + theta u'. Node j couples (u', v') at j-1, j, j+1; u' at the wall
+    // and edge nodes is fixed or follows its neighbour, v' at the wall is fixed and v' at the edge
+    // follows from C afterwards.
+    // Returns the largest change of u'.
+    f64 BoundaryLayerSolver::newton_step(const Station& cur, Station& next, f64 theta, f64 dx, f64 dUe2, f64 nu, const f64* nu_eff)
+    {
+        LW_PROFILE_ZONE("march/newton");
+        LW_PROFILE_COUNT(Solves, 1);
+        const u32 jmax = m_jmax;
+        const u32 n    = jmax-2;
+        const f64 h = 0.5 / dx;
+        const f64* d1  = m_metrics.d1.data();
+        const f64* lo2 = m_metrics.d2_lower.data();
+        const f64* up2 = m_metrics.d2_upper.data();
+        const f64* dy  = m_metrics.dy.data();
+        const f64* u0 = cur.u;
+        const f64* v0 = cur.v;
+        f64* u1 = next.u;
+        f64* v1 = next.v;
+
+        rows::with_viscosity(nu, nu_eff, [&](auto visc) {
+            for (u32 j = 1; j < jmax-1; j++)
+            {
+                u32 k = j-1;
+                f64 lower = visc.lower(j) * lo2[j];
+                f64 upper = visc.upper(j) * up2[j];
+
+                f64 ubar = ( 1.0 - theta ) * u0[j] + theta * u1[j];
+                f64 uy1  = ( u1[j+1] - u1[j-1] ) * d1[j];
+                f64 uy0  = ( u0[j+1] - u0[j-1] ) * d1[j];
+                f64 L1   = v1[j] * uy1 - lower * ( u1[j-1] - u1[j] ) - upper * ( u1[j+1] - u1[j] );
+                f64 L0   = v0[j] * uy0 - lower * ( u0[j-1] - u0[j] ) - upper * ( u0[j+1] - u0[j] );
+                f64 M    = ubar * ( u1[j] - u0[j] ) + theta * dx * L1 + ( 1.0 - theta ) * dx * L0 - 0.5 * dUe2;
+
+                f64 hj = dy[j-1] * h;
+                f64 C  = theta * ( v1[j] - v1[j-1] ) + ( 1.0 - theta ) * ( v0[j] - v0[j-1] ) + hj * ( u1[j] - u0[j] + u1[j-1] - u0[j-1] );
+
+                f64 td = theta * dx;
+                m_block.lower[k] = { -td * ( v1[j] * d1[j] + lower ), 0.0, hj, -theta };
+                m_block.diag[k]  = { ubar + theta * ( u1[j] - u0[j] ) + td * ( lower + upper ), td * uy1, hj, theta };
+                m_block.upper[k] = { td * ( v1[j] * d1[j] - upper ), 0.0, 0.0, 0.0 };
+                m_delta[k] = { -M, -C };
+            }
+        });
+
+        // fixed ends drop out, a zero gradient end moves its u' coupling onto the diagonal
+        m_block.diag[0][0]   += m_wall_row.alpha * m_block.lower[0][0];
+        m_block.diag[0][2]   += m_wall_row.alpha * m_block.lower[0][2];
+        m_block.diag[n-1][0] += m_edge_row.alpha * m_block.upper[n-1][0];
+        m_block.diag[n-1][2] += m_edge_row.alpha * m_block.upper[n-1][2];
+        m_block.lower[0]   = {};
+        m_block.upper[n-1] = {};
+
+        thomas_block2(m_block, m_delta.data(), m_block_scratch.data());
+        m_solves++;
+
+        f64 change = 0.0;
+        for (u32 j = 1; j < jmax-1; j++)
+        {
+            u1[j] += m_delta[j-1][0];
+            v1[j] += m_delta[j-1][1];
+            change = std::max(change, std::abs(m_delta[j-1][0]));
+        }
+        copy_boundaries(next);
+
+        const u32 J = jmax-1;
+        v1[J] = v1[J-1] - ( ( 1.0 - theta ) * ( v0[J] - v0[J-1] ) + dy[J-1] * h * ( u1[J] - u0[J] + u1[J-1] - u0[J-1] ) ) / theta;
+        return change;
+    }
+
+    void BoundaryLayerSolver::solve_momentum(Station& next)
+    {
+        LW_PROFILE_ZONE("march/tdma");
+        LW_PROFILE_COUNT(Solves, 1);
+        const u32 jmax = m_jmax;
+        const u32 n    = jmax-2;
+
+        // wall and edge nodes enter through the first and last rows, u_b = alpha u(neighbour) + beta
+        m_A.diag[0]   += m_wall_row.alpha * m_A.lower[0];
+        m_rhs[0]      -= m_A.lower[0] * m_wall_row.beta;
+        m_A.diag[n-1] += m_edge_row.alpha * m_A.upper[n-1];
+        m_rhs[n-1]    -= m_A.upper[n-1] * m_edge_row.beta;
+        m_A.lower[0]   = 0.0;
+        m_A.upper[n-1] = 0.0;
+
+        tridiagonal_solve(m_A, m_rhs, m_workspace);
+        m_solves++;
+
+        for (u32 j = 1; j < jmax-1; j++)
+            next.u[j] = m_rhs[j-1];
+        copy_boundaries(next);
+    }
+
+    // fixed boundary values of station i+1 from the classified nodes, no slip on Wall and the
+    // edge velocity on Inlet nodes, and the end rows they fold into. v(0) = 0 is the integration
+    // constant of continuity whatever the type of the wall side: no transpiration.
+    void BoundaryLayerSolver::fix_boundaries(Station& next)
+    {
+        apply_value(m_boundaries[BoundaryType::Wall], next.u, 0.0);
+        apply_value(m_boundaries[BoundaryType::Inlet], next.u, next.Ue);
+        next.v[0] = 0.0;
+
+        auto row = [](BoundaryType t, f64 value) { return zero_gradient(t) ? BoundaryRow{ 1.0, 0.0 } : BoundaryRow{ 0.0, value }; };
+        m_wall_row = row(m_boundary_spec[Side::Wall], next.u[0]);
+        m_edge_row = row(m_boundary_spec[Side::Edge], next.u[m_jmax-1]);
+    }
+
+    // Symmetry and Outlet nodes follow the solved interior
+    void BoundaryLayerSolver::copy_boundaries(Station& next)
+    {
+        apply_zero_gradient(m_boundaries[BoundaryType::Symmetry], next.u);
+        apply_zero_gradient(m_boundaries[BoundaryType::Outlet], next.u);
+    }
+
+    // continuity, trapezoidal in y. The two-point difference in x is centred between the
+    // stations, the Theta scheme needs v at i+1 itself and uses the three-point backward
+    // difference once two stations are available.
+    void BoundaryLayerSolver::continuity(const Station* prev, const Station& cur, Station& next)
+    {
+        LW_PROFILE_ZONE("march/continuity");
+        const f64 dx = next.x - cur.x;
+        if (prev)
+            rows::continuity_backward(m_jmax, m_metrics.dy.data(), dx, cur.x - prev->x, prev->u, cur.u, next.u, next.v);
+        else
+            rows::continuity_centred(m_jmax, m_metrics.dy.data(), dx, cur.u, next.u, next.v);
+    }
+
+    MarchingStats BoundaryLayerSolver::solve_streaming(u32 imax, const StationPosition& x, const EdgeVelocity& Ue, f64 nu,
+                                                       const std::vector<f64>& y, std::vector<f64>& u, std::vector<f64>& v,
+                                                       const StationCallback& sink)
+    {
+        const u32 jmax = m_jmax;
+        set_mesh(y);
+        MarchingStats stats;
+        const u64 solves_at_start = m_solves;
+
+        // station ring: previous, current, next
+        f64* prev_u = m_adaptive[0];  f64* prev_v = m_adaptive[1];
+        f64* cur_u  = m_adaptive[2];  f64* cur_v  = m_adaptive[3];
+        f64* next_u = m_adaptive[4];  f64* next_v = m_adaptive[5];
+
+        std::copy(u.begin(), u.begin() + jmax, cur_u);
+        std::copy(v.begin(), v.begin() + jmax, cur_v);
+
+        f64 x0 = x(0);
+        Station prev = { x0, Ue(x0), prev_u, prev_v };
+        Station cur  = { x0, Ue(x0), cur_u,  cur_v  };
+        begin_integrals(imax);
+        reduce(cur.x, cur.Ue, cur.u, nu);
+        if (sink)
+            sink(0, cur.x, cur.u, cur.v);
+
+        for (u32 i = 1; i < imax; i++)
+        {
+            f64 xi = x(i);
+            Station next = { xi, Ue(xi), next_u, next_v };
+            advance(i > 1 ? &prev : nullptr, cur, next, nu);
+
+            f64* u_free = prev_u;
+            f64* v_free = prev_v;
+            prev_u = cur_u;   prev_v = cur_v;
+            cur_u  = next_u;  cur_v  = next_v;
+            next_u = u_free;  next_v = v_free;
+            prev = { cur.x,  cur.Ue,  prev_u, prev_v };
+            cur  = { next.x, next.Ue, cur_u,  cur_v  };
+            stats.steps++;
+
+            reduce(cur.x, cur.Ue, cur.u, nu);
+            if (sink)
+                sink(i, cur.x, cur.u, cur.v);
+        }
+
+        std::copy(cur_u, cur_u + jmax, u.begin());
+        std::copy(cur_v, cur_v + jmax, v.begin());
+        stats.solves = (u32)(m_solves - solves_at_start);
+        return stats;
+    }
+
+    MarchingStats BoundaryLayerSolver::solve_adaptive(f64 x0, f64 x1, const EdgeVelocity& Ue, f64 nu, const std::vector<f64>& y,
+                                                      std::vector<f64>& u, std::vector<f64>& v, const AdaptiveStepping& settings,
+                                                      const StationCallback& on_station)
+    {
+        const u32 jmax = m_jmax;
+        set_mesh(y);
+        MarchingStats stats;
+        const u64 solves_at_start = m_solves;
+
+        // the predictor is the embedded lower order solution, its local error shrinks like dx^2
+        const MarchingScheme scheme = m_scheme;
+        m_scheme = MarchingScheme::Theta;
+
+        // station buffers: previous, current, next
+        f64* prev_u = m_adaptive[0];  f64* prev_v = m_adaptive[1];
+        f64* cur_u  = m_adaptive[2];  f64* cur_v  = m_adaptive[3];
+        f64* next_u = m_adaptive[4];  f64* next_v = m_adaptive[5];
+
+        std::copy(u.begin(), u.begin() + jmax, cur_u);
+        std::copy(v.begin(), v.begin() + jmax, cur_v);
+
+        Station prev = { x0, Ue(x0), prev_u, prev_v };
+        Station cur  = { x0, Ue(x0), cur_u,  cur_v  };
+        bool has_prev = false;
+
+        begin_integrals(0);
+        reduce(cur.x, cur.Ue, cur.u, nu);
+        if (on_station)
+            on_station(0, cur.x, cur.u, cur.v);
+
+        f64 dx = std::clamp(settings.dx_initial, settings.dx_min, settings.dx_max);
+        while (cur.x < x1)
+        {
+            bool last = cur.x + dx >= x1 * (1.0 - 1e-12);
+            if (last)
+                dx = x1 - cur.x;
+
+            Station next = { cur.x + dx, Ue(cur.x + dx), next_u, next_v };
+            advance(has_prev ? &prev : nullptr, cur, next, nu);
+
+            f64 err = 0.0;
+            for (u32 j = 1; j < jmax-1; j++)
+                err = std::max(err, std::abs(next_u[j] - m_predicted[j]));
+            err /= std::max(std::abs(next.Ue), 1e-30);
+
+            f64 factor = err > 0.0 ? settings.safety * std::sqrt(settings.tolerance / err) : settings.max_growth;
+            factor = std::clamp(factor, settings.min_shrink, settings.max_growth);
+
+            if (err <= settings.tolerance || dx <= settings.dx_min)
+            {
+                // rotate the buffers, the current station becomes the history for the next step
+                f64* u_free = prev_u;
+                f64* v_free = prev_v;
+                prev_u = cur_u;   prev_v = cur_v;
+                cur_u  = next_u;  cur_v  = next_v;
+                next_u = u_free;  next_v = v_free;
+                prev = { cur.x,  cur.Ue,  prev_u, prev_v };
+                cur  = { next.x, next.Ue, cur_u,  cur_v  };
+                has_prev = true;
+                stats.steps++;
+
+                reduce(cur.x, cur.Ue, cur.u, nu);
+                if (on_station)
+                    on_station(stats.steps, cur.x, cur.u, cur.v);
+                if (last)
+                    break;
+            }
+            else
+            {
+                stats.rejected++;
+            }
+            dx = std::clamp(dx * factor, settings.dx_min, settings.dx_max);
+        }
+
+        std::copy(cur_u, cur_u + jmax, u.begin());
+        std::copy(cur_v, cur_v + jmax, v.begin());
+        stats.solves = (u32)(m_solves - solves_at_start);
+        m_scheme = scheme;
+        return stats;
+    }
+}
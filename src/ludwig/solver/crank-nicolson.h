@@ -0,0 +1,223 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <vector>
+
+#include "vk/vk.h"
+#include "tridiagonal.h"
+#include "tdma-parallel.h"
+#include "tdma-block.h"
+#include "integrals.h"
+#include "turbulence.h"
+#include "ludwig/mesh/boundary.h"
+#include "ludwig/mesh/structured-mesh.h"
+#include "ludwig/core/arena.h"
+
+namespace ludwig::solve
+{
+    enum class MarchingScheme : u8
+    {
+        Implicit = 0, // implicit diffusion, explicit convection, coefficients lagged at station i
+        Theta,        // theta-method on diffusion and convection, predictor-corrector coefficients
+        Newton,       // theta-method with momentum and continuity solved together for u and v by Newton's method
+    };
+
+    // one streamwise station: position, edge velocity and its contiguous u, v profiles (jmax)
+    struct Station
+    {
+        f64  x  = 0.0;
+        f64  Ue = 0.0;
+        f64* u  = nullptr;
+        f64* v  = nullptr;
+    };
+
+    // step control for BoundaryLayerSolver::solve_adaptive
+    struct AdaptiveStepping
+    {
+        f64 tolerance  = 1e-4;  // predictor-corrector difference per step, relative to the edge velocity
+        f64 dx_initial = 1e-4;
+        f64 dx_min     = 1e-7;
+        f64 dx_max     = 1e-1;
+        f64 safety     = 0.9;
+        f64 min_shrink = 0.2;
+        f64 max_growth = 2.0;
+    };
+
+    // per-station iteration of the Theta and Newton schemes. Theta: Picard passes that re-evaluate
+    // the coefficients from the latest iterate of station i+1. Newton: updates of u and v on the
+    // coupled equations, starting from the Implicit step. Either stops after max_iterations, or
+    // once the largest change of u in a pass falls below tolerance times the edge velocity
+    // (tolerance = 0 always runs every pass).
+    struct NonlinearIteration
+    {
+        u32 max_iterations = 2;
+        f64 tolerance      = 0.0;
+    };
+
+    struct MarchingStats
+    {
+        u32 steps    = 0; // accepted stations
+        u32 rejected = 0; // steps retried with a smaller dx
+        u32 solves   = 0; // tridiagonal solves
+    };
+
+    using EdgeVelocity    = std::function<f64(f64 x)>;
+    using StationPosition = std::function<f64(u32 i)>;
+    using StationCallback = std::function<void(u32 i, f64 x, const f64* u, const f64* v)>;
+
+    // Marches the 2D boundary-layer equations downstream one station at a time.
+    // u(i,j), v(i,j): i is the streamwise station, j the wall-normal node.
+    //
+    // The Theta scheme weights the x-derivative between stations i and i+1 with theta:
+    // theta = 1 is backward Euler, theta = 0.5 is Crank-Nicolson. The coefficients u, v of the
+    // linearised equation are evaluated at x(i) + theta dx from a predictor step taken with the
+    // coefficients of station i and two corrector passes, which keeps theta = 0.5 second order
+    // in x at three solves per station.
+    //
+    // Picard passes converge slowly at large dx: v follows from continuity as (u' - u) / dx, so
+    // a small change of u moves v by O(1). The Newton scheme removes that lag by solving
+    // for u and v together, momentum and continuity at every node form 2x2 blocks of a block
+    // tridiagonal system (the Keller box arrangement for theta = 0.5). It converges in a few
+    // passes and keeps theta = 0.5 second order at steps where the Theta scheme breaks down.
+    //
+    // The wall (j = 0) and edge (j = jmax-1) nodes take the conditions of their BoundaryType,
+    // classified into index lists once per mesh size: fixed values are set before the solve
+    // and folded into the end rows, zero gradient nodes copy the interior afterwards. The
+    // interior assembly loops over j = 1..jmax-2 hold no boundary or viscosity tests.
+    //
+    // With a turbulence model the diffusion term becomes (nu_eff u_y)_y, nu_eff taken at the
+    // half nodes from the eddy viscosity of station i.
+    //
+    // All work buffers are sized from the mesh dimensions at construction and reused across
+    // stations and across repeated solve() calls, so the marching loop itself never touches
+    // the heap (serial tridiagonal path). The per-station profiles are carved at exact size from
+    // a caller's arena (one block for the field and every solver) or from a solver-owned one.
+    class BoundaryLayerSolver
+    {
+    public:
+        BoundaryLayerSolver() = default;
+        BoundaryLayerSolver(u32 imax, u32 jmax, core::Arena* arena = nullptr);
+
+        // re-size the work buffers, the only call that allocates. The station profiles are
+        // carved from `arena` when given, which must outlive the solver and have arena_bytes(jmax)
+        // free (every resize carves again), from a solver-owned block of that size otherwise
+        void resize(u32 imax, u32 jmax, core::Arena* arena = nullptr);
+
+        // bytes resize() carves for jmax wall-normal nodes
+        static u64 arena_bytes(u32 jmax);
+
+        // march stations 1..imax-1 from the inflow profile held in station 0 of u and v.
+        // x: station positions (imax), y: wall-normal node positions (jmax),
+        // Ue: edge velocity per station (imax), nu: kinematic viscosity
+        void solve(const std::vector<f64>& x, const std::vector<f64>& y, const std::vector<f64>& Ue, f64 nu,
+                   Matrix<f64>& u, Matrix<f64>& v);
+
+        // same march on a StructuredMesh, reusing its precomputed wall-normal metrics
+        void solve(const StructuredMesh& mesh, const std::vector<f64>& Ue, f64 nu, Matrix<f64>& u, Matrix<f64>& v);
+
+        // BoundaryType of the wall and edge sides, no slip wall and edge velocity (Inlet) by default;
+        // Symmetry or Outlet on either side holds a zero normal gradient of u. Setup only, the
+        // node lists are rebuilt (and allocated) here and in resize()
+        void set_boundaries(const BoundarySpec& spec);
+        const BoundarySpec& boundaries() const { return m_boundary_spec; }
+
+        // wall-normal metrics used by step() and advance(), set by solve() and solve_adaptive()
+        void set_mesh(const std::vector<f64>& y);
+        void set_mesh(const StructuredMesh& mesh);
+
+        // advance station i to i+1 (momentum, then continuity)
+        void step(u32 i, const std::vector<f64>& x, const std::vector<f64>& Ue, f64 nu,
+                  Matrix<f64>& u, Matrix<f64>& v);
+
+        // march from x0 to x1 with the Theta scheme, choosing dx per station: the first order
+        // predictor of every step is an embedded lower order solution, its difference to the
+        // corrected station estimates the local error and dx grows or shrinks within the settings
+        // bounds. u and v hold the inflow profile on entry and the profile at x1 on exit, every
+        // accepted station is passed to on_station.
+        MarchingStats solve_adaptive(f64 x0, f64 x1, const EdgeVelocity& Ue, f64 nu, const std::vector<f64>& y,
+                                     std::vector<f64>& u, std::vector<f64>& v, const AdaptiveStepping& settings,
+                                     const StationCallback& on_station = {});
+
+        // march stations 1..imax-1 at positions x(i) with the current scheme, keeping only a ring
+        // of three stations so memory is O(jmax) however long the march. u and v hold the inflow
+        // profile on entry and the last station on exit, every station from the inflow on is
+        // handed to sink as it completes.
+        MarchingStats solve_streaming(u32 imax, const StationPosition& x, const EdgeVelocity& Ue, f64 nu, const std::vector<f64>& y,
+                                      std::vector<f64>& u, std::vector<f64>& v, const StationCallback& sink);
+
+        // advance cur to next.x given the station before it (or nullptr at the inflow)
+        void advance(const Station* prev, const Station& cur, Station& next, f64 nu);
+
+        // when set, every solve*() call clears `integrals` and appends the integral quantities of
+        // each station as it completes (inflow included); nullptr turns the reduction off
+        void set_integrals(StationIntegrals* integrals) { m_integrals = integrals; }
+
+        // eddy viscosity model, evaluated from the lagged station i into nu_eff before each step
+        void set_turbulence(const EddyViscosity& model) { m_turbulence = model; }
+        const EddyViscosity& turbulence() const { return m_turbulence; }
+
+        void set_scheme(MarchingScheme scheme, f64 theta = 0.5) { m_scheme = scheme; m_theta = theta; }
+        void set_iteration(const NonlinearIteration& iteration) { m_iteration = iteration; }
+        const NonlinearIteration& iteration() const { return m_iteration; }
+        MarchingScheme scheme() const { return m_scheme; }
+        f64 theta() const { return m_theta; }
+
+        u32 imax() const { return m_imax; }
+        u32 jmax() const { return m_jmax; }
+
+        TridiagonalWorkspace<f64>& workspace() { return m_workspace; }
+        u64 solves() const { return m_solves; }
+
+    private:
+        void march(const std::vector<f64>& x, const std::vector<f64>& Ue, f64 nu, Matrix<f64>& u, Matrix<f64>& v);
+        void begin_integrals(u64 stations);
+        void reduce(f64 x, f64 Ue, const f64* u, f64 nu);
+        void assemble_implicit(const Station& cur, f64 dx, f64 dUe2, f64 nu, const f64* nu_eff);
+        void assemble_theta(const Station& cur, const f64* ubar, const f64* vbar, f64 dx, f64 dUe2, f64 nu, const f64* nu_eff);
+        void solve_momentum(Station& next);
+        void fix_boundaries(Station& next);
+        void copy_boundaries(Station& next);
+        f64 newton_step(const Station& cur, Station& next, f64 theta, f64 dx, f64 dUe2, f64 nu, const f64* nu_eff);
+        f64 change(const f64* u) const;
+        void continuity(const Station* prev, const Station& cur, Station& next);
+
+    private:
+        u32 m_imax = 0;
+        u32 m_jmax = 0;
+
+        MarchingScheme m_scheme = MarchingScheme::Implicit;
+        EddyViscosity m_turbulence;
+        f64 m_theta = 1.0;
+        NonlinearIteration m_iteration;
+
+        // u of a wall or edge node as alpha u(neighbour) + beta, folded into the end rows
+        struct BoundaryRow
+        {
+            f64 alpha = 0.0;
+            f64 beta  = 0.0;
+        };
+
+        WallNormalMetrics m_metrics;
+        BoundarySpec m_boundary_spec;
+        BoundaryNodes m_boundaries;   // wall and edge nodes of one station by type
+        BoundaryRow m_wall_row;
+        BoundaryRow m_edge_row;
+        TriDiagonal<f64> m_A;     // interior nodes j = 1..jmax-2
+        std::vector<f64> m_rhs;   // right hand side in, u(i+1, 1..jmax-2) out
+        TridiagonalWorkspace<f64> m_workspace;
+        BlockTriDiagonal2<f64> m_block;                 // Newton scheme, (u, v) per interior node
+        std::vector<std::array<f64, 2>> m_delta;
+        std::vector<Block2<f64>> m_block_scratch;
+
+        core::Arena m_arena;          // backs the jmax profiles below unless resize() was given an arena
+        f64* m_ubar = nullptr;        // Theta scheme coefficients at x(i) + theta dx
+        f64* m_vbar = nullptr;
+        f64* m_predicted = nullptr;   // u(i+1) after the predictor, the embedded error estimate
+        f64* m_iterate = nullptr;     // u(i+1) before the latest corrector pass
+        f64* m_nu_eff = nullptr;      // nu + nu_t of the current station, turbulent steps only
+        std::array<f64*, 6> m_adaptive = {}; // station ring for solve_adaptive and solve_streaming
+        u64 m_solves = 0;
+        StationIntegrals* m_integrals = nullptr;
+    };
+}
@@ -0,0 +1,372 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "vk/vk.h"
+#include "ludwig/core/thread-pool.h"
+
+namespace ludwig::solve
+{
+    namespace detail
+    {
+        // panel width of the blocked factorizations and column tile of their trailing updates:
+        // a 64 x 256 tile of U12 (or L21) is 128 kB and stays in L2 while it updates every row
+        constexpr u32 dense_block = 64;
+        constexpr u32 dense_tile  = 256;
+
+        // run body(r0, r1) over [begin, end) in blocks of dense_block rows, on the pool if given
+        template<typename F>
+        void for_row_blocks(u32 begin, u32 end, core::ThreadPool* pool, F&& body)
+        {
+            if (begin >= end)
+                return;
+            const u32 blocks = ( end - begin + dense_block - 1 ) / dense_block;
+            auto block = [&](u32 b, u32) { body(begin + b * dense_block, std::min(end, begin + ( b + 1 ) * dense_block)); };
+            if (pool && blocks > 1)
+                pool->for_each(blocks, block);
+            else
+                for (u32 b = 0; b < blocks; b++)
+                    block(b, 0);
+        }
+    }
+
+    // LU factorization with partial pivoting, P A = L U, L unit lower and U upper packed into
+    // one n x n row-major matrix. Right-looking and blocked: a panel of dense_block columns is
+    // factored, then the trailing matrix takes the rank-dense_block update A22 -= L21 U12 in
+    // column tiles, row blocks spread over the pool. O(n^3) like the unblocked algorithm, but
+    // every U12 tile is reused by all rows while it is cache resident.
+    //
+    // The factors are kept, so any number of right-hand sides, the determinant and the inverse
+    // cost O(n^2) per column afterwards.
+    template<typename T>
+    class LUFactorization
+    {
+    public:
+        LUFactorization() = default;
+        explicit LUFactorization(const Matrix<T>& A, core::ThreadPool* pool = nullptr) { factor(A, pool); }
+
+        // false when A is singular (an exactly zero pivot); the factors are then incomplete
+        bool factor(const Matrix<T>& A, core::ThreadPool* pool = nullptr)
+        {
+            const u32 n = A.dim1;
+            m_n = n;
+            m_lu = A;
+            m_pivot.resize(n);
+            m_sign = 1;
+            m_singular = false;
+
+            T* a = &m_lu(0, 0);
+            for (u32 k0 = 0; k0 < n; k0 += detail::dense_block)
+            {
+                const u32 k1 = std::min(n, k0 + detail::dense_block);
+
+                // panel k0..k1-1 with pivoting, full rows swapped
+                for (u32 k = k0; k < k1; k++)
+                {
+                    u32 p = k;
+                    T big = std::abs(a[(u64)k * n + k]);
+                    for (u32 i = k + 1; i < n; i++)
+                    {
+                        T v = std::abs(a[(u64)i * n + k]);
+                        if (v > big)
+                        {
+                            big = v;
+                            p = i;
+                        }
+                    }
+                    m_pivot[k] = p;
+                    if (big == T(0))
+                    {
+                        m_singular = true;
+                        continue;
+                    }
+                    if (p != k)
+                    {
+                        std::swap_ranges(a + (u64)k * n, a + (u64)k * n + n, a + (u64)p * n);
+                        m_sign = -m_sign;
+                    }
+
+                    const T r = T(1) / a[(u64)k * n + k];
+                    for (u32 i = k + 1; i < n; i++)
+                    {
+                        T* row = a + (u64)i * n;
+                        row[k] *= r;
+                        const T l = row[k];
+                        for (u32 j = k + 1; j < k1; j++)
+                            row[j] -= l * a[(u64)k * n + j];
+                    }
+                }
+                if (k1 == n)
+                    break;
+
+                // U12 = L11^-1 A12
+                for (u32 k = k0; k < k1; k++)
+                    for (u32 i = k + 1; i < k1; i++)
+                    {
+                        const T l = a[(u64)i * n + k];
+                        for (u32 j = k1; j < n; j++)
+                            a[(u64)i * n + j] -= l * a[(u64)k * n + j];
+                    }
+
+                // A22 -= L21 U12
+                detail::for_row_blocks(k1, n, pool, [&](u32 r0, u32 r1) {
+                    for (u32 j0 = k1; j0 < n; j0 += detail::dense_tile)
+                    {
+                        const u32 j1 = std::min(n, j0 + detail::dense_tile);
+                        for (u32 i = r0; i < r1; i++)
+                        {
+                            T* row = a + (u64)i * n;
+                            for (u32 k = k0; k < k1; k++)
+                            {
+                                const T l = row[k];
+                                const T* u = a + (u64)k * n;
+                                for (u32 j = j0; j < j1; j++)
+                                    row[j] -= l * u[j];
+                            }
+                        }
+                    }
+                });
+            }
+            return !m_singular;
+        }
+
+        // A x = b in place, b holds n values
+        void solve(T* b) const
+        {
+            const u32 n = m_n;
+            const T* a = &m_lu(0, 0);
+            for (u32 k = 0; k < n; k++)
+                std::swap(b[k], b[m_pivot[k]]);
+            for (u32 i = 1; i < n; i++)
+            {
+                T s = b[i];
+                for (u32 k = 0; k < i; k++)
+                    s -= a[(u64)i * n + k] * b[k];
+                b[i] = s;
+            }
+            for (u32 i = n; i-- > 0; )
+            {
+                T s = b[i];
+                for (u32 k = i + 1; k < n; k++)
+                    s -= a[(u64)i * n + k] * b[k];
+                b[i] = s / a[(u64)i * n + i];
+            }
+        }
+
+        void solve(std::vector<T>& b) const { solve(b.data()); }
+
+        // A X = B in place for every column of B (n x m), row operations over all columns at once
+        void solve(Matrix<T>& B) const
+        {
+            const u32 n = m_n;
+            const u32 m = B.dim2;
+            const T* a = &m_lu(0, 0);
+            T* b = &B(0, 0);
+            for (u32 k = 0; k < n; k++)
+                if (m_pivot[k] != k)
+                    std::swap_ranges(b + (u64)k * m, b + (u64)k * m + m, b + (u64)m_pivot[k] * m);
+            for (u32 i = 1; i < n; i++)
+                for (u32 k = 0; k < i; k++)
+                {
+                    const T l = a[(u64)i * n + k];
+                    for (u32 c = 0; c < m; c++)
+                        b[(u64)i * m + c] -= l * b[(u64)k * m + c];
+                }
+            for (u32 i = n; i-- > 0; )
+            {
+                for (u32 k = i + 1; k < n; k++)
+                {
+                    const T u = a[(u64)i * n + k];
+                    for (u32 c = 0; c < m; c++)
+                        b[(u64)i * m + c] -= u * b[(u64)k * m + c];
+                }
+                const T r = T(1) / a[(u64)i * n + i];
+                for (u32 c = 0; c < m; c++)
+                    b[(u64)i * m + c] *= r;
+            }
+        }
+
+        T determinant() const
+        {
+            if (m_singular)
+                return T(0);
+            T d = T(m_sign);
+            for (u32 i = 0; i < m_n; i++)
+                d *= m_lu(i, i);
+            return d;
+        }
+
+        Matrix<T> inverse() const
+        {
+            Matrix<T> X(m_n, m_n, T(0));
+            for (u32 i = 0; i < m_n; i++)
+                X(i, i) = T(1);
+            solve(X);
+            return X;
+        }
+
+        u32 size() const { return m_n; }
+        bool singular() const { return m_singular; }
+        const Matrix<T>& factors() const { return m_lu; }
+
+    private:
+        u32 m_n = 0;
+        Matrix<T> m_lu;
+        std::vector<u32> m_pivot; // row k was swapped with row m_pivot[k] at step k
+        int m_sign = 1;
+        bool m_singular = false;
+    };
+
+    // Cholesky factorization A = L L^T of a symmetric positive definite matrix, L kept in the
+    // lower triangle (only the lower triangle of A is read). Blocked like LUFactorization, the
+    // trailing update A22 -= L21 L21^T touches the lower triangle only, about half the flops
+    // of LU and no pivoting.
+    template<typename T>
+    class CholeskyFactorization
+    {
+    public:
+        CholeskyFactorization() = default;
+        explicit CholeskyFactorization(const Matrix<T>& A, core::ThreadPool* pool = nullptr) { factor(A, pool); }
+
+        // false when A is not positive definite
+        bool factor(const Matrix<T>& A, core::ThreadPool* pool = nullptr)
+        {
+            const u32 n = A.dim1;
+            m_n = n;
+            m_l = A;
+            m_panel.resize((u64)detail::dense_block * n);
+            m_definite = true;
+
+            T* a = &m_l(0, 0);
+            for (u32 k0 = 0; k0 < n; k0 += detail::dense_block)
+            {
+                const u32 k1 = std::min(n, k0 + detail::dense_block);
+
+                // L11 and L21 column by column, the updates of earlier panels are already in
+                for (u32 k = k0; k < k1; k++)
+                {
+                    T* rk = a + (u64)k * n;
+                    T d = rk[k];
+                    for (u32 p = k0; p < k; p++)
+                        d -= rk[p] * rk[p];
+                    if (!( d > T(0) ))
+                    {
+                        m_definite = false;
+                        return false;
+                    }
+                    rk[k] = std::sqrt(d);
+                    const T r = T(1) / rk[k];
+
+                    for (u32 i = k + 1; i < n; i++)
+                    {
+                        T* ri = a + (u64)i * n;
+                        T s = ri[k];
+                        for (u32 p = k0; p < k; p++)
+                            s -= ri[p] * rk[p];
+                        ri[k] = s * r;
+                    }
+                }
+                if (k1 == n)
+                    break;
+
+                // A22 -= L21 L21^T, lower triangle. L21 is packed transposed first, so the update
+                // of row i is a run of contiguous axpys instead of dot products down columns
+                const u32 w = k1 - k0;
+                for (u32 j = k1; j < n; j++)
+                    for (u32 p = k0; p < k1; p++)
+                        m_panel[(u64)( p - k0 ) * n + j] = a[(u64)j * n + p];
+
+                detail::for_row_blocks(k1, n, pool, [&](u32 r0, u32 r1) {
+                    for (u32 i = r0; i < r1; i++)
+                    {
+                        T* ri = a + (u64)i * n;
+                        for (u32 p = 0; p < w; p++)
+                        {
+                            const T l = ri[k0 + p];
+                            const T* lt = m_panel.data() + (u64)p * n;
+                            for (u32 j = k1; j <= i; j++)
+                                ri[j] -= l * lt[j];
+                        }
+                    }
+                });
+            }
+
+            // clear the upper triangle so factors() reads as L
+            for (u32 i = 0; i < n; i++)
+                std::fill(a + (u64)i * n + i + 1, a + (u64)i * n + n, T(0));
+            return true;
+        }
+
+        // A x = b in place: L y = b, then L^T x = y
+        void solve(T* b) const
+        {
+            const u32 n = m_n;
+            const T* a = &m_l(0, 0);
+            for (u32 i = 0; i < n; i++)
+            {
+                T s = b[i];
+                for (u32 k = 0; k < i; k++)
+                    s -= a[(u64)i * n + k] * b[k];
+                b[i] = s / a[(u64)i * n + i];
+            }
+            for (u32 i = n; i-- > 0; )
+            {
+                b[i] /= a[(u64)i * n + i];
+                const T x = b[i];
+                for (u32 k = 0; k < i; k++)
+                    b[k] -= a[(u64)i * n + k] * x;
+            }
+        }
+
+        void solve(std::vector<T>& b) const { solve(b.data()); }
+
+        T determinant() const
+        {
+            T d = T(1);
+            for (u32 i = 0; i < m_n; i++)
+                d *= m_l(i, i) * m_l(i, i);
+            return d;
+        }
+
+        Matrix<T> inverse() const
+        {
+            Matrix<T> X(m_n, m_n, T(0));
+            std::vector<T> e(m_n);
+            for (u32 c = 0; c < m_n; c++)
+            {
+                std::fill(e.begin(), e.end(), T(0));
+                e[c] = T(1);
+                solve(e.data());
+                for (u32 i = 0; i < m_n; i++)
+                    X(i, c) = e[i];
+            }
+            return X;
+        }
+
+        u32 size() const { return m_n; }
+        bool definite() const { return m_definite; }
+        const Matrix<T>& factors() const { return m_l; }
+
+    private:
+        u32 m_n = 0;
+        Matrix<T> m_l;
+        std::vector<T> m_panel; // L21 of the current panel, transposed
+        bool m_definite = false;
+    };
+
+    // |A| through LU in O(n^3), in place of cofactor expansion
+    template<typename T>
+    T determinant(const Matrix<T>& A, core::ThreadPool* pool = nullptr)
+    {
+        return LUFactorization<T>(A, pool).determinant();
+    }
+
+    // A^-1 from one LU and n solves; a singular A gives non-finite entries
+    template<typename T>
+    Matrix<T> inverse(const Matrix<T>& A, core::ThreadPool* pool = nullptr)
+    {
+        return LUFactorization<T>(A, pool).inverse();
+    }
+}
@@ -0,0 +1,247 @@
+#include "energy.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "ludwig/core/aligned.h"
+#include "ludwig/core/profile.h"
+
+namespace ludwig::solve
+{
+    ThermalBoundaryLayerSolver::ThermalBoundaryLayerSolver(u32 jmax, core::Arena* arena)
+    {
+        resize(jmax, arena);
+    }
+
+    u64 ThermalBoundaryLayerSolver::arena_bytes(u32 jmax)
+    {
+        return 4 * core::padded_size<f64>(jmax) * sizeof(f64) + core::cache_line;
+    }
+
+    void ThermalBoundaryLayerSolver::resize(u32 jmax, core::Arena* arena)
+    {
+        m_jmax = jmax;
+        m_metrics.resize(jmax);
+        m_A.resize(jmax-2, 2);
+        m_rhs.assign(2 * (u64)(jmax-2), 0.0);
+        m_scratch.assign(2 * (u64)(jmax-2), 0.0);
+
+        if (!arena)
+        {
+            m_arena.reserve(arena_bytes(jmax));
+            arena = &m_arena;
+        }
+        const u64 row = core::padded_size<f64>(jmax);
+        auto carve = [&]() {
+            f64* p = arena->allocate_array<f64>(row);
+            std::fill_n(p, row, 0.0);
+            return p;
+        };
+        m_mu       = carve();
+        m_rho      = carve();
+        m_k        = carve();
+        m_rho_next = carve();
+    }
+
+    // the metrics are sized for the solver's jmax, a mesh of another height needs resize() first
+    void ThermalBoundaryLayerSolver::set_mesh(const std::vector<f64>& y)
+    {
+        assert(y.size() == m_jmax);
+        m_metrics.compute(y);
+    }
+
+    void ThermalBoundaryLayerSolver::set_mesh(const StructuredMesh& mesh)
+    {
+        assert(mesh.jmax == m_jmax);
+        m_metrics = mesh.metrics;
+    }
+
+    void ThermalBoundaryLayerSolver::solve(const StructuredMesh& mesh, const std::vector<f64>& Ue, f64 Te,
+                                           Matrix<f64>& u, Matrix<f64>& v, Matrix<f64>& T)
+    {
+        set_mesh(mesh);
+        if (m_integrals)
+        {
+            m_integrals->clear();
+            m_integrals->reserve(mesh.imax);
+        }
+        reduce({ mesh.x[0], Ue[0], &u(0, 0), &v(0, 0), &T(0, 0) }, Te);
+        for (u32 i = 0; i < mesh.imax-1; i++)
+        {
+            ThermalStation cur  = { mesh.x[i],   Ue[i],   &u(i, 0),   &v(i, 0),   &T(i, 0) };
+            ThermalStation next = { mesh.x[i+1], Ue[i+1], &u(i+1, 0), &v(i+1, 0), &T(i+1, 0) };
+            advance(cur, next, Te);
+            reduce(next, Te);
+        }
+    }
+
+    void ThermalBoundaryLayerSolver::reduce(const ThermalStation& station, f64 Te)
+    {
+        if (m_integrals)
+        {
+            f64 nu = m_properties.viscosity(station.T[0]) / m_properties.density(Te);
+            m_integrals->push(station.x, integrate_station(station.u, station.Ue, nu, m_metrics));
+        }
+    }
+
+    void ThermalBoundaryLayerSolver::update_properties(const f64* T, f64* mu, f64* rho, f64* k) const
+    {
+        for (u32 j = 0; j < m_jmax; j++)
+        {
+            mu[j]  = m_properties.viscosity(T[j]);
+            rho[j] = m_properties.density(T[j]);
+            if (k)
+                k[j] = m_properties.conductivity(mu[j]);
+        }
+    }
+
+    void ThermalBoundaryLayerSolver::advance(const ThermalStation& cur, ThermalStation& next, f64 Te)
+    {
+        LW_PROFILE_ZONE("thermal/station");
+        LW_PROFILE_COUNT(Stations, 1);
+        const u32 jmax = m_jmax;
+        const u32 n    = jmax-2;
+        const f64 dx   = next.x - cur.x;
+        const f64 dUe2 = next.Ue*next.Ue - cur.Ue*cur.Ue;
+
+        {
+            LW_PROFILE_ZONE("thermal/assemble");
+            update_properties(cur.T, m_mu, m_rho, m_k);
+            assemble(cur, dx, dUe2, m_properties.density(Te));
+            boundary_rows(next, Te);
+        }
+
+        // momentum and energy in one pass of the batched recurrence
+        {
+            LW_PROFILE_ZONE("thermal/tdma");
+            LW_PROFILE_COUNT(Solves, 1);
+            thomas_batched(m_A.lower.data(), m_A.diag.data(), m_A.upper.data(), m_rhs.data(), m_scratch.data(), n, 2u, 0u, 2u);
+        }
+
+        for (u32 j = 1; j < jmax-1; j++)
+        {
+            next.u[j] = m_rhs[m_A.index(j-1, 0)];
+            next.T[j] = m_rhs[m_A.index(j-1, 1)];
+        }
+        if (m_wall == ThermalWall::Adiabatic)
+        {
+            const std::array<f64, 3>& g = m_metrics.wall_gradient;
+            next.T[0] = -( g[1] * next.T[1] + g[2] * next.T[2] ) / g[0];
+        }
+
+        LW_PROFILE_ZONE("thermal/continuity");
+        continuity(cur, next);
+    }
+
+    // both equations divided by rho u, the diffusion coefficients taken at the half nodes:
+    //   momentum  u' - dx / (rho u) (mu u'_y)_y     = u - dx v/u u_y + rho_e / rho dUe2 / (2 u)
+    //   energy    T' - dx / (rho cp u) (k T'_y)_y   = T - dx v/u T_y + dx / (rho cp u) mu u_y^2
+    void ThermalBoundaryLayerSolver::assemble(const ThermalStation& cur, f64 dx, f64 dUe2, f64 rho_e)
+    {
+        const f64* d1  = m_metrics.d1.data();
+        const f64* lo2 = m_metrics.d2_lower.data();
+        const f64* up2 = m_metrics.d2_upper.data();
+        const f64* u = cur.u;
+        const f64* v = cur.v;
+        const f64* T = cur.T;
+        const f64* mu  = m_mu;
+        const f64* rho = m_rho;
+        const f64* k   = m_k;
+        const f64 inv_cp = 1.0 / m_properties.gas.cp;
+        const f64 heating = m_dissipation ? 1.0 : 0.0;
+
+        f64* a = m_A.lower.data();
+        f64* b = m_A.diag.data();
+        f64* c = m_A.upper.data();
+        f64* d = m_rhs.data();
+
+        for (u32 j = 1; j < m_jmax-1; j++)
+        {
+            u64 m = 2 * (u64)(j-1);
+            u64 e = m + 1;
+
+            f64 r    = 1.0 / u[j];
+            f64 g    = dx * r / rho[j];
+            f64 beta = v[j] * r * dx * d1[j];
+            f64 dudy = ( u[j+1] - u[j-1] ) * d1[j];
+
+            f64 lower = g * 0.5 * ( mu[j-1] + mu[j] ) * lo2[j];
+            f64 upper = g * 0.5 * ( mu[j] + mu[j+1] ) * up2[j];
+            a[m] = -lower;
+            b[m] = 1.0 + lower + upper;
+            c[m] = -upper;
+            d[m] = u[j] - beta * ( u[j+1] - u[j-1] ) + 0.5 * dUe2 * r * rho_e / rho[j];
+
+            lower = g * inv_cp * 0.5 * ( k[j-1] + k[j] ) * lo2[j];
+            upper = g * inv_cp * 0.5 * ( k[j] + k[j+1] ) * up2[j];
+            a[e] = -lower;
+            b[e] = 1.0 + lower + upper;
+            c[e] = -upper;
+            d[e] = T[j] - beta * ( T[j+1] - T[j-1] ) + heating * g * inv_cp * mu[j] * dudy * dudy;
+        }
+    }
+
+    // no slip, edge velocity and temperature at the top, wall temperature or zero gradient
+    void ThermalBoundaryLayerSolver::boundary_rows(ThermalStation& next, f64 Te)
+    {
+        const u32 jmax = m_jmax;
+        const u32 n    = jmax-2;
+        const u64 top  = 2 * (u64)(n-1);
+        f64* a = m_A.lower.data();
+        f64* b = m_A.diag.data();
+        f64* c = m_A.upper.data();
+        f64* d = m_rhs.data();
+
+        next.u[0]      = 0.0;
+        next.v[0]      = 0.0;
+        next.u[jmax-1] = next.Ue;
+        next.T[jmax-1] = Te;
+
+        d[top]     -= c[top] * next.Ue;
+        d[top + 1] -= c[top + 1] * Te;
+        c[top]      = 0.0;
+        c[top + 1]  = 0.0;
+
+        if (m_wall == ThermalWall::Isothermal)
+        {
+            next.T[0] = m_T_wall;
+            d[1] -= a[1] * m_T_wall;
+        }
+        else
+        {
+            // one-sided second order gradient g0 T0 + g1 T1 + g2 T2 = 0 eliminates T0, row 1
+            // keeps its tridiagonal shape
+            const std::array<f64, 3>& g = m_metrics.wall_gradient;
+            b[1] -= a[1] * g[1] / g[0];
+            c[1] -= a[1] * g[2] / g[0];
+        }
+        a[0] = 0.0;
+        a[1] = 0.0;
+    }
+
+    // continuity on the mass flux, two-point in x and trapezoidal in y:
+    //   (rho v)(j+1) = (rho v)(j) - dy / (2 dx) [ (rho u)' - (rho u) ](j, j+1)
+    void ThermalBoundaryLayerSolver::continuity(const ThermalStation& cur, ThermalStation& next)
+    {
+        const u32 jmax = m_jmax;
+        const f64 h = 1.0 / ( 2.0 * ( next.x - cur.x ) );
+        const f64* dy = m_metrics.dy.data();
+        const f64* r0 = m_rho;
+        f64* r1 = m_rho_next;
+        update_properties(next.T, m_mu, r1, nullptr);
+
+        f64 flux = 0.0;
+        for (u32 j = 0; j < jmax-1; j++)
+        {
+            flux -= dy[j] * h * ( r1[j+1] * next.u[j+1] - r0[j+1] * cur.u[j+1] + r1[j] * next.u[j] - r0[j] * cur.u[j] );
+            next.v[j+1] = flux / r1[j+1];
+        }
+    }
+
+    f64 ThermalBoundaryLayerSolver::wall_heat_flux(const f64* T) const
+    {
+        const std::array<f64, 3>& w = m_metrics.wall_gradient;
+        f64 k = m_properties.conductivity(m_properties.viscosity(T[0]));
+        return -k * ( w[0] * T[0] + w[1] * T[1] + w[2] * T[2] );
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+
+#include "vk/vk.h"
+#include "tdma-batched.h"
+#include "integrals.h"
+#include "ludwig/core/arena.h"
+#include "ludwig/flow/propeties.h"
+#include "ludwig/mesh/structured-mesh.h"
+
+namespace ludwig::solve
+{
+    enum class ThermalWall : u8
+    {
+        Isothermal = 0, // T = T_wall
+        Adiabatic,      // dT/dy = 0
+    };
+
+    // one streamwise station with its temperature profile, all jmax long
+    struct ThermalStation
+    {
+        f64  x  = 0.0;
+        f64  Ue = 0.0;
+        f64* u  = nullptr;
+        f64* v  = nullptr;
+        f64* T  = nullptr;
+    };
+
+    // Marches the compressible boundary-layer equations at low Mach number:
+    //   rho (u u_x + v u_y) = rho_e Ue Ue_x + (mu u_y)_y
+    //   rho cp (u T_x + v T_y) = (k T_y)_y + mu u_y^2
+    //   (rho u)_x + (rho v)_y = 0
+    // with mu(T), rho(T) and k(T) from GasProperties, evaluated at station i. The scheme is the
+    // Implicit one of BoundaryLayerSolver: diffusion implicit, convection and coefficients
+    // lagged, so momentum and energy are two independent tridiagonal systems per station and
+    // go through a single batched Thomas call. Continuity then uses the density of station i+1.
+    class ThermalBoundaryLayerSolver
+    {
+    public:
+        ThermalBoundaryLayerSolver() = default;
+        explicit ThermalBoundaryLayerSolver(u32 jmax, core::Arena* arena = nullptr);
+
+        // re-size the work buffers, the only call that allocates; the property profiles are
+        // carved from `arena` as in BoundaryLayerSolver::resize
+        void resize(u32 jmax, core::Arena* arena = nullptr);
+
+        // bytes resize() carves for jmax wall-normal nodes
+        static u64 arena_bytes(u32 jmax);
+
+        void set_mesh(const std::vector<f64>& y);
+        void set_mesh(const StructuredMesh& mesh);
+
+        void set_properties(const GasProperties& properties) { m_properties = properties; }
+        void set_wall(ThermalWall wall, f64 T_wall = 0.0) { m_wall = wall; m_T_wall = T_wall; }
+        void set_dissipation(bool dissipation) { m_dissipation = dissipation; }
+
+        // when set, solve() clears `integrals` and appends the integral quantities of each station
+        // as BoundaryLayerSolver does, the thicknesses from u / Ue and cf from the wall viscosity,
+        // cf = 2 mu_w (du/dy)_wall / (rho_e Ue^2); nullptr turns the reduction off
+        void set_integrals(StationIntegrals* integrals) { m_integrals = integrals; }
+
+        const GasProperties& properties() const { return m_properties; }
+
+        // march stations 1..imax-1 from the inflow held in station 0 of u, v and T; Te is the
+        // edge temperature, Ue the edge velocity per station
+        void solve(const StructuredMesh& mesh, const std::vector<f64>& Ue, f64 Te,
+                   Matrix<f64>& u, Matrix<f64>& v, Matrix<f64>& T);
+
+        // advance cur to next.x
+        void advance(const ThermalStation& cur, ThermalStation& next, f64 Te);
+
+        // wall heat flux into the fluid, -k_w (dT/dy)_wall
+        f64 wall_heat_flux(const f64* T) const;
+
+        u32 jmax() const { return m_jmax; }
+
+    private:
+        void update_properties(const f64* T, f64* mu, f64* rho, f64* k) const;
+        void assemble(const ThermalStation& cur, f64 dx, f64 dUe2, f64 rho_e);
+        void boundary_rows(ThermalStation& next, f64 Te);
+        void continuity(const ThermalStation& cur, ThermalStation& next);
+        void reduce(const ThermalStation& station, f64 Te);
+
+    private:
+        u32 m_jmax = 0;
+
+        GasProperties m_properties;
+        ThermalWall m_wall = ThermalWall::Isothermal;
+        f64 m_T_wall = 0.0;
+        bool m_dissipation = true;
+        StationIntegrals* m_integrals = nullptr;
+
+        WallNormalMetrics m_metrics;
+        BatchedTriDiagonal<f64> m_A;  // system 0 momentum, 1 energy, interior nodes
+        std::vector<f64> m_rhs;
+        std::vector<f64> m_scratch;
+
+        core::Arena m_arena;          // backs the jmax property profiles below unless resize() was given an arena
+        f64* m_mu  = nullptr;         // station i
+        f64* m_rho = nullptr;
+        f64* m_k   = nullptr;
+        f64* m_rho_next = nullptr;    // station i+1, for continuity
+    };
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+
+#include "vk/vk.h"
+#include "ludwig/mesh/structured-mesh.h"
+
+namespace ludwig::solve
+{
+    struct IntegralQuantities
+    {
+        f64 displacement_thickness = 0.0; // delta* = int (1 - u/Ue) dy
+        f64 momentum_thickness     = 0.0; // theta  = int u/Ue (1 - u/Ue) dy
+        f64 shape_factor           = 0.0; // H = delta* / theta
+        f64 skin_friction          = 0.0; // cf = 2 nu (du/dy)_wall / Ue^2
+    };
+
+    // one pass over the station with the precomputed quadrature and wall-gradient weights
+    inline IntegralQuantities integrate_station(const f64* u, f64 Ue, f64 nu, const WallNormalMetrics& m)
+    {
+        const f64* w = m.quadrature.data();
+        const u32 jmax = (u32)m.quadrature.size();
+        const f64 r = 1.0 / Ue;
+
+        f64 delta1 = 0.0;
+        f64 delta2 = 0.0;
+        for (u32 j = 0; j < jmax; j++)
+        {
+            f64 q = u[j] * r;
+            delta1 += w[j] * ( 1.0 - q );
+            delta2 += w[j] * q * ( 1.0 - q );
+        }
+
+        IntegralQuantities out;
+        out.displacement_thickness = delta1;
+        out.momentum_thickness     = delta2;
+        out.shape_factor           = delta2 > 0.0 ? delta1 / delta2 : 0.0;
+        f64 dudy = m.wall_gradient[0] * u[0] + m.wall_gradient[1] * u[1] + m.wall_gradient[2] * u[2];
+        out.skin_friction = 2.0 * nu * dudy * r * r;
+        return out;
+    }
+
+    // integral quantities per station, one compact array each
+    struct StationIntegrals
+    {
+        std::vector<f64> x;
+        std::vector<f64> displacement_thickness;
+        std::vector<f64> momentum_thickness;
+        std::vector<f64> shape_factor;
+        std::vector<f64> skin_friction;
+
+        u64 size() const { return x.size(); }
+
+        void reserve(u64 n)
+        {
+            for (std::vector<f64>* a : { &x, &displacement_thickness, &momentum_thickness, &shape_factor, &skin_friction })
+                a->reserve(n);
+        }
+
+        void clear()
+        {
+            for (std::vector<f64>* a : { &x, &displacement_thickness, &momentum_thickness, &shape_factor, &skin_friction })
+                a->clear();
+        }
+
+        void push(f64 xi, const IntegralQuantities& q)
+        {
+            x.push_back(xi);
+            displacement_thickness.push_back(q.displacement_thickness);
+            momentum_thickness.push_back(q.momentum_thickness);
+            shape_factor.push_back(q.shape_factor);
+            skin_friction.push_back(q.skin_friction);
+        }
+    };
+}
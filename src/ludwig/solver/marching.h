@@ -0,0 +1,181 @@
+#pragma once
+
+#include <vector>
+
+#include "vk/vk.h"
+#include "tdma.h"
+#include "tridiagonal.h"
+#include "ludwig/mesh/structured-mesh.h"
+
+namespace ludwig::solve
+{
+    // Row kernels of the marching schemes, templated on the scalar type so BoundaryLayerSolver
+    // (f64) and the differentiated march (a dual number) assemble and integrate the same
+    // equations.
+    namespace rows
+    {
+        // viscosity at the faces j -+ 1/2 of node j: constant, or the eddy viscosity averaged from
+        // the nodes. Chosen once per station, so the interior kernels are instantiated for each
+        // and their loops carry no branch and vectorize.
+        struct ConstantViscosity
+        {
+            f64 nu;
+            f64 lower(u32) const { return nu; }
+            f64 upper(u32) const { return nu; }
+        };
+
+        struct NodalViscosity
+        {
+            const f64* nu;
+            f64 lower(u32 j) const { return 0.5 * ( nu[j-1] + nu[j] ); }
+            f64 upper(u32 j) const { return 0.5 * ( nu[j] + nu[j+1] ); }
+        };
+
+        template<typename F>
+        void with_viscosity(f64 nu, const f64* nu_eff, F&& kernel)
+        {
+            if (nu_eff)
+                kernel(NodalViscosity{ nu_eff });
+            else
+                kernel(ConstantViscosity{ nu });
+        }
+
+        // Momentum rows of the interior nodes j = 1..jmax-2, row j-1 of the tridiagonal system.
+        // Diffusion implicit, convection lagged at station i. The boundary nodes are only read as
+        // neighbours and the outputs alias nothing, so the loops are straight-line code the
+        // compiler can vectorize.
+        template<typename T, typename Viscosity>
+        void implicit_rows(u32 jmax, const WallNormalMetrics& metrics, const T* u, const T* v, f64 dx, const T& dUe2, Viscosity visc,
+                           T* __restrict A_lower, T* __restrict A_diag, T* __restrict A_upper, T* __restrict rhs)
+        {
+            const f64* d1  = metrics.d1.data();
+            const f64* lo2 = metrics.d2_lower.data();
+            const f64* up2 = metrics.d2_upper.data();
+            for (u32 j = 1; j < jmax-1; j++)
+            {
+                T r     = 1.0 / u[j];
+                T lower = visc.lower(j) * r * dx * lo2[j];
+                T upper = visc.upper(j) * r * dx * up2[j];
+                T beta  = v[j] * r * dx * d1[j];
+
+                A_lower[j-1] = -lower;
+                A_diag[j-1]  = 1.0 + lower + upper;
+                A_upper[j-1] = -upper;
+                rhs[j-1]     = u[j] - beta * ( u[j+1] - u[j-1] ) + 0.5 * dUe2 * r;
+            }
+        }
+
+        // theta-weighted momentum rows with the coefficients ubar, vbar, see assemble_theta
+        template<typename T, typename Viscosity>
+        void theta_rows(u32 jmax, const WallNormalMetrics& metrics, const T* u, const T* ubar, const T* vbar, f64 theta, f64 dx, const T& dUe2,
+                        Viscosity visc, T* __restrict A_lower, T* __restrict A_diag, T* __restrict A_upper, T* __restrict rhs)
+        {
+            const f64* d1  = metrics.d1.data();
+            const f64* lo2 = metrics.d2_lower.data();
+            const f64* up2 = metrics.d2_upper.data();
+            for (u32 j = 1; j < jmax-1; j++)
+            {
+                f64 nl = visc.lower(j);
+                f64 nh = visc.upper(j);
+                T cl = nl * lo2[j] + vbar[j] * d1[j];
+                T cu = nh * up2[j] - vbar[j] * d1[j];
+                f64 cd = -( nl * lo2[j] + nh * up2[j] );
+
+                T r  = 1.0 / ubar[j];
+                T kx = dx * r;
+                T ki = theta * kx;
+                T ke = ( 1.0 - theta ) * kx;
+
+                A_lower[j-1] = -ki * cl;
+                A_diag[j-1]  = 1.0 - ki * cd;
+                A_upper[j-1] = -ki * cu;
+                rhs[j-1]     = u[j] + ke * ( cl * u[j-1] + cd * u[j] + cu * u[j+1] ) + 0.5 * dUe2 * r;
+            }
+        }
+
+        // continuity, trapezoidal in y, v1 integrated up from v1[0] with the two-point difference
+        // in x centred between the stations
+        template<typename T>
+        void continuity_centred(u32 jmax, const f64* dy, f64 dx, const T* u0, const T* u1, T* v1)
+        {
+            for (u32 j = 0; j < jmax-1; j++)
+                v1[j+1] = v1[j] - dy[j] / ( 2.0 * dx ) * ( u1[j+1] - u0[j+1] + u1[j] - u0[j] );
+        }
+
+        // the same with the three-point backward difference at station i+1, um at x - dx - h0
+        template<typename T>
+        void continuity_backward(u32 jmax, const f64* dy, f64 dx, f64 h0, const T* um, const T* u0, const T* u1, T* v1)
+        {
+            const f64 c1 = ( 2.0 * dx + h0 ) / ( dx * ( dx + h0 ) );
+            const f64 c0 = -( dx + h0 ) / ( dx * h0 );
+            const f64 cm = dx / ( h0 * ( dx + h0 ) );
+            for (u32 j = 0; j < jmax-1; j++)
+            {
+                T ux0 = c1 * u1[j]   + c0 * u0[j]   + cm * um[j];
+                T ux1 = c1 * u1[j+1] + c0 * u0[j+1] + cm * um[j+1];
+                v1[j+1] = v1[j] - 0.5 * dy[j] * ( ux0 + ux1 );
+            }
+        }
+    }
+
+    // BoundaryLayerSolver's laminar Implicit step on the shared row kernels, for any scalar type.
+    // With a dual number the derivatives of every station with respect to the parameters of Ue
+    // and the inflow travel through the same assembly and TDMA<T>, which is what the optimizer
+    // differentiates.
+    template<typename T>
+    class MarchingKernel
+    {
+    public:
+        MarchingKernel() = default;
+        explicit MarchingKernel(u32 jmax) { resize(jmax); }
+
+        void resize(u32 jmax)
+        {
+            m_jmax = jmax;
+            m_A.resize(jmax-2);
+            m_rhs.assign(jmax-2, T(0));
+            m_scratch.assign(jmax-2, T(0));
+        }
+
+        // advance (u0, v0) with edge velocity Ue0 by dx to (u1, v1) with Ue1, profiles of jmax
+        void advance(const WallNormalMetrics& m, f64 dx, const T& Ue0, const T& Ue1, f64 nu,
+                     const T* u0, const T* v0, T* u1, T* v1)
+        {
+            const u32 jmax = m_jmax;
+            const u32 n    = jmax-2;
+            const T dUe2   = Ue1*Ue1 - Ue0*Ue0;
+
+            u1[0]      = T(0);
+            v1[0]      = T(0);
+            u1[jmax-1] = Ue1;
+
+            rows::implicit_rows(jmax, m, u0, v0, dx, dUe2, rows::ConstantViscosity{ nu },
+                                m_A.lower.data(), m_A.diag.data(), m_A.upper.data(), m_rhs.data());
+            m_rhs[n-1]     -= m_A.upper[n-1] * u1[jmax-1];
+            m_A.lower[0]   = T(0);
+            m_A.upper[n-1] = T(0);
+
+            TDMA(m_A, m_rhs, m_scratch);
+            for (u32 j = 1; j < jmax-1; j++)
+                u1[j] = m_rhs[j-1];
+
+            rows::continuity_centred(jmax, m.dy.data(), dx, u0, u1, v1);
+        }
+
+        u32 jmax() const { return m_jmax; }
+
+    private:
+        u32 m_jmax = 0;
+        TriDiagonal<T> m_A;
+        std::vector<T> m_rhs;
+        std::vector<T> m_scratch;
+    };
+
+    // cf = 2 nu (du/dy)_wall / Ue^2 of one station, as integrate_station
+    template<typename T>
+    T skin_friction(const T* u, const T& Ue, f64 nu, const WallNormalMetrics& m)
+    {
+        T dudy = m.wall_gradient[0] * u[0] + m.wall_gradient[1] * u[1] + m.wall_gradient[2] * u[2];
+        return 2.0 * nu * dudy / ( Ue * Ue );
+    }
+}
@@ -1,3 +1,8 @@
+#pragma once
+
 #include "crank-nicolson.h"
+#include "energy.h"
+#include "spanwise.h"
+#include "sweep.h"
 
 // ludwig::solver::Solver(Feild)
@@ -0,0 +1,174 @@
+#include "spanwise.h"
+
+#include <algorithm>
+
+#include "ludwig/core/aligned.h"
+#include "ludwig/core/profile.h"
+
+namespace ludwig::solve
+{
+    SpanwiseMarcher::SpanwiseMarcher(u32 nz, u32 jmax, u32 threads)
+    {
+        resize(nz, jmax);
+        set_threads(threads);
+    }
+
+    void SpanwiseMarcher::resize(u32 nz, u32 jmax)
+    {
+        m_nz = nz;
+        m_jmax = jmax;
+        m_metrics.resize(jmax);
+        m_A.resize(jmax-2, nz);
+        m_rhs_u.assign((u64)(jmax-2) * nz, 0.0);
+        m_rhs_w.assign((u64)(jmax-2) * nz, 0.0);
+        m_scratch.assign((u64)(jmax-2) * nz, 0.0);
+        m_stations.assign(6 * (u64)jmax * nz, 0.0);
+        set_threads(threads());
+    }
+
+    void SpanwiseMarcher::set_threads(u32 threads)
+    {
+        threads = std::max(threads, 1u);
+        if (threads == 1)
+            m_pool.reset();
+        else if (!m_pool || m_pool->size() != threads)
+            m_pool = std::make_unique<core::ThreadPool>(threads);
+
+        // a few blocks per thread for balance, never splitting a cache line between threads
+        u32 lanes = core::padded_size<f64>(1);
+        u32 blocks = threads == 1 ? 1 : 4 * threads;
+        m_block = std::max(( m_nz + blocks - 1 ) / blocks, 1u);
+        m_block = ( m_block + lanes - 1 ) / lanes * lanes;
+    }
+
+    void SpanwiseMarcher::set_mesh(const std::vector<f64>& y)
+    {
+        m_metrics.compute(y);
+    }
+
+    void SpanwiseMarcher::solve(const std::vector<f64>& x, const Matrix<f64>& Ue, const std::vector<f64>& We, f64 nu,
+                                std::vector<f64>& u, std::vector<f64>& v, std::vector<f64>& w, const SpanwiseCallback& on_station)
+    {
+        const u64 plane = (u64)m_jmax * m_nz;
+        f64* buffers = m_stations.data();
+        std::copy(u.begin(), u.begin() + plane, buffers);
+        std::copy(v.begin(), v.begin() + plane, buffers + plane);
+        std::copy(w.begin(), w.begin() + plane, buffers + 2 * plane);
+
+        SpanwiseStation cur  = { x[0], &Ue(0, 0), buffers, buffers + plane, buffers + 2 * plane };
+        SpanwiseStation next = { 0.0, nullptr, buffers + 3 * plane, buffers + 4 * plane, buffers + 5 * plane };
+        if (on_station)
+            on_station(0, cur);
+
+        for (u32 i = 1; i < x.size(); i++)
+        {
+            next.x = x[i];
+            next.Ue = &Ue(i, 0);
+            advance(cur, next, We.data(), nu);
+            std::swap(cur, next);
+            if (on_station)
+                on_station(i, cur);
+        }
+
+        std::copy(cur.u, cur.u + plane, u.begin());
+        std::copy(cur.v, cur.v + plane, v.begin());
+        std::copy(cur.w, cur.w + plane, w.begin());
+    }
+
+    void SpanwiseMarcher::advance(const SpanwiseStation& cur, SpanwiseStation& next, const f64* We, f64 nu)
+    {
+        LW_PROFILE_ZONE("spanwise/station");
+        LW_PROFILE_COUNT(Stations, m_nz);
+        if (!m_pool || m_block >= m_nz)
+        {
+            advance_block(cur, next, We, nu, 0, m_nz);
+            return;
+        }
+
+        u32 blocks = ( m_nz + m_block - 1 ) / m_block;
+        m_pool->for_each(blocks, [&](u32 b, u32) {
+            advance_block(cur, next, We, nu, b * m_block, std::min(( b + 1 ) * m_block, m_nz));
+        });
+    }
+
+    void SpanwiseMarcher::advance_block(const SpanwiseStation& cur, SpanwiseStation& next, const f64* We, f64 nu, u32 k0, u32 k1)
+    {
+        LW_PROFILE_ZONE("spanwise/block");
+        LW_PROFILE_COUNT(Solves, 2 * ( k1 - k0 ));
+        const u32 nz   = m_nz;
+        const u32 jmax = m_jmax;
+        const u32 n    = jmax - 2;
+        const f64 dx   = next.x - cur.x;
+        const f64* d1  = m_metrics.d1.data();
+        const f64* lo2 = m_metrics.d2_lower.data();
+        const f64* up2 = m_metrics.d2_upper.data();
+        const f64* dy  = m_metrics.dy.data();
+
+        const f64* u = cur.u;
+        const f64* v = cur.v;
+        const f64* w = cur.w;
+        f64* a  = m_A.lower.data();
+        f64* b  = m_A.diag.data();
+        f64* c  = m_A.upper.data();
+        f64* ru = m_rhs_u.data();
+        f64* rw = m_rhs_w.data();
+
+        // implicit diffusion, explicit convection, coefficients lagged at station i; row j-1 of
+        // the batched system is node j, contiguous over the columns
+        for (u32 j = 1; j < jmax-1; j++)
+        {
+            const u64 o = (u64)(j-1) * nz;
+            const u64 p = (u64)j * nz;
+            for (u32 k = k0; k < k1; k++)
+            {
+                f64 r     = 1.0 / u[p + k];
+                f64 alpha = nu * r * dx;
+                f64 beta  = v[p + k] * r * dx * d1[j];
+                f64 dUe2  = next.Ue[k] * next.Ue[k] - cur.Ue[k] * cur.Ue[k];
+
+                a[o + k]  = -alpha * lo2[j];
+                b[o + k]  = 1.0 + alpha * ( lo2[j] + up2[j] );
+                c[o + k]  = -alpha * up2[j];
+                ru[o + k] = u[p + k] - beta * ( u[p + nz + k] - u[p - nz + k] ) + 0.5 * dUe2 * r;
+                rw[o + k] = w[p + k] - beta * ( w[p + nz + k] - w[p - nz + k] );
+            }
+        }
+
+        // no slip at the wall (u = w = 0), edge values at the top, folded into the end rows
+        const u64 top = (u64)(n-1) * nz;
+        for (u32 k = k0; k < k1; k++)
+        {
+            next.u[k] = 0.0;
+            next.v[k] = 0.0;
+            next.w[k] = 0.0;
+            next.u[(u64)(jmax-1) * nz + k] = next.Ue[k];
+            next.w[(u64)(jmax-1) * nz + k] = We[k];
+
+            ru[top + k] -= c[top + k] * next.Ue[k];
+            rw[top + k] -= c[top + k] * We[k];
+            a[k] = 0.0;
+            c[top + k] = 0.0;
+        }
+
+        thomas_batched(a, b, c, ru, m_scratch.data(), n, nz, k0, k1);
+        thomas_batched(a, b, c, rw, m_scratch.data(), n, nz, k0, k1);
+
+        for (u32 j = 1; j < jmax-1; j++)
+        {
+            const u64 o = (u64)(j-1) * nz;
+            const u64 p = (u64)j * nz;
+            std::copy(ru + o + k0, ru + o + k1, next.u + p + k0);
+            std::copy(rw + o + k0, rw + o + k1, next.w + p + k0);
+        }
+
+        // continuity, two-point in x and trapezoidal in y
+        const f64 h = 1.0 / ( 2.0 * dx );
+        for (u32 j = 0; j < jmax-1; j++)
+        {
+            const u64 p = (u64)j * nz;
+            const u64 q = p + nz;
+            for (u32 k = k0; k < k1; k++)
+                next.v[q + k] = next.v[p + k] - dy[j] * h * ( next.u[q + k] - u[q + k] + next.u[p + k] - u[p + k] );
+        }
+    }
+}
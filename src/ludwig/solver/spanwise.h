@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "vk/vk.h"
+#include "tdma-batched.h"
+#include "ludwig/core/thread-pool.h"
+#include "ludwig/mesh/structured-mesh.h"
+
+namespace ludwig::solve
+{
+    // one streamwise station of nz spanwise columns. Profiles are node-major, column fastest:
+    // u[j * nz + k] is node j of column k, so a row of the batched system is contiguous.
+    struct SpanwiseStation
+    {
+        f64 x = 0.0;
+        const f64* Ue = nullptr; // chordwise edge velocity per column (nz)
+        f64* u = nullptr;        // chordwise velocity
+        f64* v = nullptr;        // wall-normal velocity
+        f64* w = nullptr;        // spanwise (crossflow) velocity
+    };
+
+    using SpanwiseCallback = std::function<void(u32 i, const SpanwiseStation& station)>;
+
+    // Quasi-3D boundary layers: infinite-swept or slowly varying in span, each spanwise column is
+    // an independent (x, y) boundary layer with its own chordwise edge velocity Ue(x, k) and
+    // spanwise edge velocity We(k). Chordwise momentum and continuity are those of the 2D
+    // Implicit scheme, the crossflow obeys u w_x + v w_y = nu w_yy and shares the momentum
+    // operator, so both are solved with the same tridiagonal matrix.
+    //
+    // Every row of every column's system is assembled SIMD-wide across columns and solved
+    // with the batched Thomas kernel. Column blocks (whole cache lines) run on a ThreadPool.
+    class SpanwiseMarcher
+    {
+    public:
+        SpanwiseMarcher() = default;
+        SpanwiseMarcher(u32 nz, u32 jmax, u32 threads = 1);
+
+        void resize(u32 nz, u32 jmax);
+        void set_threads(u32 threads);
+        void set_mesh(const std::vector<f64>& y);
+
+        // march stations 1..imax-1. Ue is imax x nz, We holds nz values. u, v and w hold the
+        // inflow planes (jmax * nz) on entry and the last station on exit.
+        void solve(const std::vector<f64>& x, const Matrix<f64>& Ue, const std::vector<f64>& We, f64 nu,
+                   std::vector<f64>& u, std::vector<f64>& v, std::vector<f64>& w, const SpanwiseCallback& on_station = {});
+
+        // advance every column from cur to next.x
+        void advance(const SpanwiseStation& cur, SpanwiseStation& next, const f64* We, f64 nu);
+
+        u32 nz() const { return m_nz; }
+        u32 jmax() const { return m_jmax; }
+        u32 threads() const { return m_pool ? m_pool->size() : 1; }
+
+    private:
+        // columns [k0, k1) of one step
+        void advance_block(const SpanwiseStation& cur, SpanwiseStation& next, const f64* We, f64 nu, u32 k0, u32 k1);
+
+    private:
+        u32 m_nz = 0;
+        u32 m_jmax = 0;
+        u32 m_block = 0; // columns per parallel task, whole cache lines
+
+        WallNormalMetrics m_metrics;
+        BatchedTriDiagonal<f64> m_A;  // interior nodes, batch = nz
+        std::vector<f64> m_rhs_u;
+        std::vector<f64> m_rhs_w;
+        std::vector<f64> m_scratch;
+        std::vector<f64> m_stations;  // two station buffers of u, v, w for solve()
+        std::unique_ptr<core::ThreadPool> m_pool;
+    };
+}
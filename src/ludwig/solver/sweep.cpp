@@ -0,0 +1,73 @@
+#include "sweep.h"
+
+#include <cmath>
+
+#include "ludwig/core/profile.h"
+
+namespace ludwig::solve
+{
+    EddyViscosity case_turbulence(const BoundaryLayerCase& c)
+    {
+        EddyViscosity turbulence;
+        turbulence.model = c.turbulent ? TurbulenceModel::CebeciSmith : TurbulenceModel::Laminar;
+        turbulence.x_transition = c.x_transition * c.plate_length;
+        return turbulence;
+    }
+
+    CaseResult run_case(const BoundaryLayerCase& c, BoundaryLayerSolver& solver, bool keep_integrals)
+    {
+        LW_PROFILE_ZONE("sweep/case");
+        StructuredMesh mesh(c.mesh_spec());
+        if (solver.jmax() != mesh.jmax)
+            solver.resize(2, mesh.jmax);
+
+        std::vector<f64> u(mesh.jmax), v(mesh.jmax);
+        inflow_profile(c, mesh.y, mesh.x[0], mesh.x[1], u.data(), v.data());
+
+        solver.set_turbulence(case_turbulence(c));
+
+        CaseResult result;
+        solver.set_integrals(&result.integrals);
+        solver.solve_streaming(mesh.imax, [&](u32 i) { return mesh.x[i]; }, [&](f64 x) { return c.edge_velocity(x); },
+                               c.nu(), mesh.y, u, v, {});
+        solver.set_integrals(nullptr);
+
+        const StationIntegrals& s = result.integrals;
+        result.stations = (u32)s.size();
+        result.attached = result.stations;
+        for (u32 i = 0; i < result.stations; i++)
+        {
+            if (!( s.skin_friction[i] > 0.0 ) || !std::isfinite(s.displacement_thickness[i]))
+            {
+                result.attached = i;
+                result.separation_x = s.x[i];
+                break;
+            }
+        }
+
+        if (result.attached > 0)
+        {
+            u32 i = result.attached - 1;
+            result.x_exit = s.x[i];
+            result.exit = { s.displacement_thickness[i], s.momentum_thickness[i], s.shape_factor[i], s.skin_friction[i] };
+        }
+
+        if (!keep_integrals)
+            result.integrals = StationIntegrals();
+        return result;
+    }
+
+    SweepRunner::SweepRunner(u32 threads)
+        : m_pool(threads), m_solvers(m_pool.size())
+    {
+    }
+
+    std::vector<CaseResult> SweepRunner::run(const std::vector<BoundaryLayerCase>& cases, bool keep_integrals)
+    {
+        std::vector<CaseResult> results(cases.size());
+        m_pool.for_each((u32)cases.size(), [&](u32 k, u32 worker) {
+            results[k] = run_case(cases[k], m_solvers[worker], keep_integrals);
+        });
+        return results;
+    }
+}
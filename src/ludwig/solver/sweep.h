@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include "vk/vk.h"
+#include "crank-nicolson.h"
+#include "integrals.h"
+#include "ludwig/core/thread-pool.h"
+#include "ludwig/flow/case.h"
+
+namespace ludwig::solve
+{
+    struct CaseResult
+    {
+        u32 stations = 0;          // stations marched, including the inflow
+        u32 attached = 0;          // stations before the first with cf <= 0 (or a non-finite value)
+        f64 separation_x = -1.0;   // x of that station, -1 when the march stays attached
+        f64 x_exit = 0.0;          // last attached station
+        IntegralQuantities exit;   // integral quantities there
+        StationIntegrals integrals; // every station, only kept on request
+    };
+
+    // the case's laminar / Cebeci-Smith setting with the transition point in metres
+    EddyViscosity case_turbulence(const BoundaryLayerCase& c);
+
+    // marches one case with streaming output, integral quantities reduced on the fly
+    CaseResult run_case(const BoundaryLayerCase& c, BoundaryLayerSolver& solver, bool keep_integrals = false);
+
+    // Runs independent cases concurrently on a work-stealing ThreadPool. Every worker owns a
+    // BoundaryLayerSolver, so its buffers (and their arena) are reused from case to case and
+    // the workers share nothing but the result vector.
+    class SweepRunner
+    {
+    public:
+        explicit SweepRunner(u32 threads = core::hardware_threads());
+
+        // results in the order of cases
+        std::vector<CaseResult> run(const std::vector<BoundaryLayerCase>& cases, bool keep_integrals = false);
+
+        u32 threads() const { return m_pool.size(); }
+
+    private:
+        core::ThreadPool m_pool;
+        std::vector<BoundaryLayerSolver> m_solvers; // one per worker
+    };
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+#include "vk/vk.h"
+
+namespace ludwig
+{
+    // many tridiagonal systems of the same size, interleaved so that entry (row k, system s)
+    // lives at k * batch + s. For a fixed row the systems are contiguous, which lets the
+    // Thomas recurrence run across systems in SIMD lanes.
+    template<typename T>
+    struct BatchedTriDiagonal
+    {
+        u32 n     = 0; // rows per system
+        u32 batch = 0; // number of systems
+        std::vector<T> lower;
+        std::vector<T> diag;
+        std::vector<T> upper;
+
+        BatchedTriDiagonal() = default;
+        BatchedTriDiagonal(u32 rows, u32 systems) { resize(rows, systems); }
+
+        void resize(u32 rows, u32 systems)
+        {
+            n     = rows;
+            batch = systems;
+            lower.assign((u64)rows * systems, T(0));
+            diag.assign((u64)rows * systems, T(0));
+            upper.assign((u64)rows * systems, T(0));
+        }
+
+        u64 index(u32 k, u32 s) const { return (u64)k * batch + s; }
+    };
+}
+
+namespace ludwig::solve
+{
+    namespace detail
+    {
+        // lanes [s0, s1) of one row of the batched recurrence
+        template<typename T>
+        inline void thomas_forward_row(const T* a, const T* b, const T* c, T* d, T* cp,
+                                       const T* d_prev, const T* cp_prev, u32 s0, u32 s1)
+        {
+            for (u32 s = s0; s < s1; s++)
+            {
+                T m   = T(1) / ( b[s] - a[s] * cp_prev[s] );
+                cp[s] = c[s] * m;
+                d[s]  = ( d[s] - a[s] * d_prev[s] ) * m;
+            }
+        }
+
+        template<typename T>
+        inline void thomas_backward_row(const T* cp, T* d, const T* d_next, u32 s0, u32 s1)
+        {
+            for (u32 s = s0; s < s1; s++)
+                d[s] = d[s] - cp[s] * d_next[s];
+        }
+
+#if defined(__AVX512F__)
+        constexpr u32 simd_width_f64 = 8;
+#elif defined(__AVX2__)
+        constexpr u32 simd_width_f64 = 4;
+#else
+        constexpr u32 simd_width_f64 = 1;
+#endif
+
+        // explicit f64 lanes, the tail (batch % width) falls back to the scalar row
+        inline void thomas_forward_row(const f64* a, const f64* b, const f64* c, f64* d, f64* cp,
+                                       const f64* d_prev, const f64* cp_prev, u32 s0, u32 s1)
+        {
+            u32 s = s0;
+#if defined(__AVX512F__)
+            const __m512d one = _mm512_set1_pd(1.0);
+            for (; s + 8 <= s1; s += 8)
+            {
+                __m512d av = _mm512_loadu_pd(a + s);
+                __m512d m  = _mm512_div_pd(one, _mm512_sub_pd(_mm512_loadu_pd(b + s), _mm512_mul_pd(av, _mm512_loadu_pd(cp_prev + s))));
+                _mm512_storeu_pd(cp + s, _mm512_mul_pd(_mm512_loadu_pd(c + s), m));
+                _mm512_storeu_pd(d + s, _mm512_mul_pd(_mm512_sub_pd(_mm512_loadu_pd(d + s), _mm512_mul_pd(av, _mm512_loadu_pd(d_prev + s))), m));
+            }
+#elif defined(__AVX2__)
+            const __m256d one = _mm256_set1_pd(1.0);
+            for (; s + 4 <= s1; s += 4)
+            {
+                __m256d av = _mm256_loadu_pd(a + s);
+                __m256d m  = _mm256_div_pd(one, _mm256_sub_pd(_mm256_loadu_pd(b + s), _mm256_mul_pd(av, _mm256_loadu_pd(cp_prev + s))));
+                _mm256_storeu_pd(cp + s, _mm256_mul_pd(_mm256_loadu_pd(c + s), m));
+                _mm256_storeu_pd(d + s, _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(d + s), _mm256_mul_pd(av, _mm256_loadu_pd(d_prev + s))), m));
+            }
+#endif
+            thomas_forward_row<f64>(a, b, c, d, cp, d_prev, cp_prev, s, s1);
+        }
+
+        inline void thomas_backward_row(const f64* cp, f64* d, const f64* d_next, u32 s0, u32 s1)
+        {
+            u32 s = s0;
+#if defined(__AVX512F__)
+            for (; s + 8 <= s1; s += 8)
+                _mm512_storeu_pd(d + s, _mm512_sub_pd(_mm512_loadu_pd(d + s), _mm512_mul_pd(_mm512_loadu_pd(cp + s), _mm512_loadu_pd(d_next + s))));
+#elif defined(__AVX2__)
+            for (; s + 4 <= s1; s += 4)
+                _mm256_storeu_pd(d + s, _mm256_sub_pd(_mm256_loadu_pd(d + s), _mm256_mul_pd(_mm256_loadu_pd(cp + s), _mm256_loadu_pd(d_next + s))));
+#endif
+            thomas_backward_row<f64>(cp, d, d_next, s, s1);
+        }
+    }
+
+    // Thomas algorithm over the systems [s0, s1) of a batch laid out as in BatchedTriDiagonal.
+    // d holds the right hand sides on entry and the solutions on exit, cp is scratch of n * batch.
+    template<typename T>
+    void thomas_batched(const T* a, const T* b, const T* c, T* d, T* cp, u32 n, u32 batch, u32 s0, u32 s1)
+    {
+        // first row coefficients
+        for (u32 s = s0; s < s1; s++)
+        {
+            cp[s] = c[s] / b[s];
+            d[s]  = d[s] / b[s];
+        }
+
+        // forward elimination
+        for (u32 k = 1; k < n; k++)
+        {
+            u64 o = (u64)k * batch;
+            u64 p = o - batch;
+            detail::thomas_forward_row(a + o, b + o, c + o, d + o, cp + o, d + p, cp + p, s0, s1);
+        }
+
+        // back substitution
+        for (u32 k = n-1; k-- > 0; )
+        {
+            u64 o = (u64)k * batch;
+            detail::thomas_backward_row(cp + o, d + o, d + o + batch, s0, s1);
+        }
+    }
+
+    // solve every system of the batch in place, no allocations: d is overwritten by x
+    template<typename T>
+    void TDMA(const BatchedTriDiagonal<T>& A, std::vector<T>& d, std::vector<T>& scratch)
+    {
+        thomas_batched(A.lower.data(), A.diag.data(), A.upper.data(), d.data(), scratch.data(), A.n, A.batch, 0u, A.batch);
+    }
+}
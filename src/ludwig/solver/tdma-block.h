@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "vk/vk.h"
+
+namespace ludwig
+{
+    // 2x2 block, row-major: { a00, a01, a10, a11 }
+    template<typename T>
+    using Block2 = std::array<T, 4>;
+
+    // block tridiagonal matrix of 2x2 blocks for two unknowns per node,
+    // block row k reads: lower[k] X(k-1) + diag[k] X(k) + upper[k] X(k+1)
+    // lower[0] and upper[n-1] fall outside the matrix and are ignored
+    template<typename T>
+    struct BlockTriDiagonal2
+    {
+        u32 n = 0;
+        std::vector<Block2<T>> lower;
+        std::vector<Block2<T>> diag;
+        std::vector<Block2<T>> upper;
+
+        BlockTriDiagonal2() = default;
+        BlockTriDiagonal2(u32 size) { resize(size); }
+
+        void resize(u32 size)
+        {
+            n = size;
+            lower.assign(size, Block2<T>{});
+            diag.assign(size, Block2<T>{});
+            upper.assign(size, Block2<T>{});
+        }
+    };
+}
+
+namespace ludwig::solve
+{
+    namespace detail
+    {
+        template<typename T>
+        inline Block2<T> inverse(const Block2<T>& m)
+        {
+            T r = T(1) / ( m[0] * m[3] - m[1] * m[2] );
+            return { m[3] * r, -m[1] * r, -m[2] * r, m[0] * r };
+        }
+
+        template<typename T>
+        inline Block2<T> multiply(const Block2<T>& a, const Block2<T>& b)
+        {
+            return { a[0] * b[0] + a[1] * b[2], a[0] * b[1] + a[1] * b[3],
+                     a[2] * b[0] + a[3] * b[2], a[2] * b[1] + a[3] * b[3] };
+        }
+
+        template<typename T>
+        inline std::array<T, 2> multiply(const Block2<T>& a, const std::array<T, 2>& x)
+        {
+            return { a[0] * x[0] + a[1] * x[1], a[2] * x[0] + a[3] * x[1] };
+        }
+    }
+
+    // block Thomas algorithm: d holds the right hand sides (two per node) on entry and the
+    // solution on exit, cp is caller-supplied scratch of n blocks. No pivoting, the diagonal
+    // blocks must stay well conditioned after elimination.
+    template<typename T>
+    void thomas_block2(const BlockTriDiagonal2<T>& A, std::array<T, 2>* d, Block2<T>* cp)
+    {
+        const u32 n = A.n;
+
+        // first block row
+        Block2<T> m = detail::inverse(A.diag[0]);
+        cp[0] = detail::multiply(m, A.upper[0]);
+        d[0]  = detail::multiply(m, d[0]);
+
+        // forward elimination
+        for (u32 k = 1; k < n; k++)
+        {
+            const Block2<T>& l = A.lower[k];
+            Block2<T> lc = detail::multiply(l, cp[k-1]);
+            std::array<T, 2> ld = detail::multiply(l, d[k-1]);
+            const Block2<T>& b = A.diag[k];
+
+            m     = detail::inverse(Block2<T>{ b[0] - lc[0], b[1] - lc[1], b[2] - lc[2], b[3] - lc[3] });
+            cp[k] = detail::multiply(m, A.upper[k]);
+            d[k]  = detail::multiply(m, std::array<T, 2>{ d[k][0] - ld[0], d[k][1] - ld[1] });
+        }
+
+        // back substitution
+        for (u32 k = n-1; k-- > 0; )
+        {
+            std::array<T, 2> cx = detail::multiply(cp[k], d[k+1]);
+            d[k][0] -= cx[0];
+            d[k][1] -= cx[1];
+        }
+    }
+}
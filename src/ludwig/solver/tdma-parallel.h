@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "vk/vk.h"
+#include "tridiagonal.h"
+#include "tdma.h"
+#include "ludwig/core/parallel.h"
+
+namespace ludwig::solve
+{
+    enum class TridiagonalMethod : u8
+    {
+        Auto = 0,    // Thomas below the workspace threshold, partitioned above it
+        Thomas,
+        Partitioned,
+    };
+
+    // scratch for the tridiagonal solvers, sized on first use and reused afterwards
+    template<typename T>
+    struct TridiagonalWorkspace
+    {
+        u32 threads            = core::hardware_threads();
+        u32 parallel_threshold = 1u << 16; // rows, below this the serial recurrence wins
+        u32 min_block_rows     = 4096;     // smallest partition worth a thread
+
+        std::vector<T> scratch; // modified upper diagonal
+        std::vector<T> v;       // response of each block to its lower interface
+        std::vector<T> w;       // response of each block to its upper interface
+        TriDiagonal<T> reduced; // interface system, one row per partition boundary
+        std::vector<T> reduced_rhs;
+        std::vector<T> reduced_scratch;
+
+        // number of partitions the dispatcher uses for n rows, 1 means serial Thomas
+        u32 blocks_for(u32 n) const
+        {
+            if (n < parallel_threshold || threads < 2)
+                return 1;
+            return std::max(1u, std::min(threads, n / std::max(min_block_rows, 2u)));
+        }
+
+        // size everything the Auto dispatch will touch for n rows, so solves never allocate
+        void prepare(u32 n)
+        {
+            u32 blocks = blocks_for(n);
+            if (blocks > 1)
+                reserve_partitioned(n, blocks);
+            else
+                reserve(n);
+        }
+
+        void reserve(u32 n)
+        {
+            if (scratch.size() < n)
+                scratch.resize(n);
+        }
+
+        void reserve_partitioned(u32 n, u32 blocks)
+        {
+            reserve(n);
+            if (v.size() < n)
+            {
+                v.resize(n);
+                w.resize(n);
+            }
+            if (reduced.n != blocks - 1)
+            {
+                reduced.resize(blocks - 1);
+                reduced_rhs.resize(blocks - 1);
+                reduced_scratch.resize(blocks - 1);
+            }
+        }
+    };
+
+    // Partition method (Wang 1981) for a single large system. The rows are split into `blocks`
+    // partitions separated by single interface rows r_k. Every partition interior is solved
+    // independently for its right hand side (y) and for unit couplings to the interface below
+    // (v) and above (w), so that x = y - v z_{k-1} - w z_k. Substituting into the interface
+    // rows gives a small tridiagonal system for z, after which the interiors are
+    // reconstructed independently again.
+    template<typename T>
+    void TDMA_partitioned(const TriDiagonal<T>& A, std::vector<T>& d, TridiagonalWorkspace<T>& ws, u32 blocks)
+    {
+        const u32 n = A.n;
+        blocks = std::clamp(blocks, 1u, n / 2);
+        if (blocks < 2)
+        {
+            ws.reserve(n);
+            thomas(A.lower.data(), A.diag.data(), A.upper.data(), d.data(), ws.scratch.data(), n);
+            return;
+        }
+        ws.reserve_partitioned(n, blocks);
+
+        const T* a = A.lower.data();
+        const T* b = A.diag.data();
+        const T* c = A.upper.data();
+        T* x  = d.data();
+        T* cp = ws.scratch.data();
+        T* v  = ws.v.data();
+        T* w  = ws.w.data();
+
+        // interface row below partition k (the last partition has none)
+        auto interface_row = [&](u32 k) { return (u32)(((u64)(k + 1) * n) / blocks - 1); };
+        auto interior_begin = [&](u32 k) { return k == 0 ? 0u : interface_row(k - 1) + 1; };
+        auto interior_end = [&](u32 k) { return k == blocks - 1 ? n : interface_row(k); };
+
+        core::parallel_for(blocks, ws.threads, [&](u32 k)
+        {
+            const u32 lo = interior_begin(k);
+            const u32 hi = interior_end(k);
+
+            // first interior row, its lower coefficient couples to z_{k-1}
+            T m   = T(1) / b[lo];
+            cp[lo] = c[lo] * m;
+            x[lo]  = x[lo] * m;
+            v[lo]  = a[lo] * m;
+            w[lo]  = T(0);
+
+            // forward elimination, three right hand sides sharing one factorisation
+            for (u32 j = lo + 1; j < hi; j++)
+            {
+                m     = T(1) / ( b[j] - a[j] * cp[j-1] );
+                cp[j] = c[j] * m;
+                x[j]  = ( x[j] - a[j] * x[j-1] ) * m;
+                v[j]  = -a[j] * v[j-1] * m;
+                w[j]  = T(0);
+            }
+            // the upper coefficient of the last interior row couples to z_k
+            w[hi-1] = c[hi-1] * m;
+
+            // back substitution
+            for (u32 j = hi - 1; j-- > lo; )
+            {
+                x[j] = x[j] - cp[j] * x[j+1];
+                v[j] = v[j] - cp[j] * v[j+1];
+                w[j] = w[j] - cp[j] * w[j+1];
+            }
+        });
+
+        // interface system: a_r x_{r-1} + b_r z_k + c_r x_{r+1} = d_r
+        TriDiagonal<T>& R = ws.reduced;
+        for (u32 k = 0; k < blocks - 1; k++)
+        {
+            const u32 r = interface_row(k);
+            R.lower[k] = k > 0 ? -a[r] * v[r-1] : T(0);
+            R.diag[k]  = b[r] - a[r] * w[r-1] - c[r] * v[r+1];
+            R.upper[k] = k < blocks - 2 ? -c[r] * w[r+1] : T(0);
+            ws.reduced_rhs[k] = x[r] - a[r] * x[r-1] - c[r] * x[r+1];
+        }
+        TDMA(R, ws.reduced_rhs, ws.reduced_scratch);
+
+        // reconstruct the interiors from the interface values
+        const T* z = ws.reduced_rhs.data();
+        core::parallel_for(blocks, ws.threads, [&](u32 k)
+        {
+            const u32 lo = interior_begin(k);
+            const u32 hi = interior_end(k);
+            const T zlo = k > 0 ? z[k-1] : T(0);
+            const T zhi = k < blocks - 1 ? z[k] : T(0);
+            for (u32 j = lo; j < hi; j++)
+                x[j] = x[j] - v[j] * zlo - w[j] * zhi;
+            if (k < blocks - 1)
+                x[hi] = zhi;
+        });
+    }
+
+    // solve A x = d in place with the method best suited to the size of the system
+    template<typename T>
+    void tridiagonal_solve(const TriDiagonal<T>& A, std::vector<T>& d, TridiagonalWorkspace<T>& ws,
+                           TridiagonalMethod method = TridiagonalMethod::Auto)
+    {
+        if (method == TridiagonalMethod::Auto)
+            method = ws.blocks_for(A.n) > 1 ? TridiagonalMethod::Partitioned : TridiagonalMethod::Thomas;
+
+        if (method == TridiagonalMethod::Partitioned)
+        {
+            u32 blocks = std::max(2u, std::min(ws.threads, A.n / std::max(ws.min_block_rows, 2u)));
+            TDMA_partitioned(A, d, ws, blocks);
+            return;
+        }
+
+        ws.reserve(A.n);
+        thomas(A.lower.data(), A.diag.data(), A.upper.data(), d.data(), ws.scratch.data(), A.n);
+    }
+}
@@ -1,4 +1,11 @@
+#pragma once
+
+#include <vector>
+
 #include "vk/vk.h"
+#include "tridiagonal.h"
+#include "ludwig/types/types.h"
+#include "ludwig/core/view.h"
 
 namespace ludwig::solve
 {
@@ -26,6 +33,62 @@ namespace ludwig::solve
             x(i) = -A(i, i+1)*x(i+1) + b(i);
     }
 
-}
+    // Thomas algorithm on raw diagonals. d holds the right hand side on entry and the
+    // solution on exit, cp is caller-supplied scratch of at least n entries.
+    template<typename T>
+    void thomas(const T* a, const T* b, const T* c, T* d, T* cp, u32 n)
+    {
+        // first row coefficients
+        cp[0] = c[0] / b[0];
+        d[0]  = d[0] / b[0];
+
+        // forward elimination
+        for (u32 i = 1; i < n; i++)
+        {
+            T m   = T(1) / ( b[i] - a[i] * cp[i-1] );
+            cp[i] = c[i] * m;
+            d[i]  = ( d[i] - a[i] * d[i-1] ) * m;
+        }
+
+        // back substitution
+        for (u32 i = n-1; i-- > 0; )
+            d[i] = d[i] - cp[i] * d[i+1];
+    }
+
+    // the same on a right hand side spaced stride entries apart, d[k * stride]
+    template<typename T>
+    void thomas(const T* a, const T* b, const T* c, T* d, i64 stride, T* cp, u32 n)
+    {
+        cp[0] = c[0] / b[0];
+        d[0]  = d[0] / b[0];
+
+        for (u32 i = 1; i < n; i++)
+        {
+            T m   = T(1) / ( b[i] - a[i] * cp[i-1] );
+            cp[i] = c[i] * m;
+            d[i * stride] = ( d[i * stride] - a[i] * d[(i-1) * stride] ) * m;
+        }
+
+        for (u32 i = n-1; i-- > 0; )
+            d[i * stride] = d[i * stride] - cp[i] * d[(i+1) * stride];
+    }
+
+    // in-place solve of A x = d on banded storage, no allocations: d is overwritten by x
+    template<typename T>
+    void TDMA(const TriDiagonal<T>& A, std::vector<T>& d, std::vector<T>& scratch)
+    {
+        thomas(A.lower.data(), A.diag.data(), A.upper.data(), d.data(), scratch.data(), A.n);
+    }
 
+    // in place on a view, e.g. the interior of a station inside a Matrix or an Array3 line,
+    // with the unit-stride loop whenever the view is contiguous
+    template<typename T>
+    void TDMA(const TriDiagonal<T>& A, core::ArrayView<T> d, std::vector<T>& scratch)
+    {
+        if (d.contiguous())
+            thomas(A.lower.data(), A.diag.data(), A.upper.data(), d.data, scratch.data(), A.n);
+        else
+            thomas(A.lower.data(), A.diag.data(), A.upper.data(), d.data, d.stride, scratch.data(), A.n);
+    }
 
+}
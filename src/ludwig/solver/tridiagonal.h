@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+#include "vk/vk.h"
+
+namespace ludwig
+{
+    // tridiagonal matrix stored as three contiguous diagonals (structure of arrays)
+    // row k reads: lower[k] * x(k-1) + diag[k] * x(k) + upper[k] * x(k+1)
+    // lower[0] and upper[n-1] fall outside the matrix and must be left at zero
+    template<typename T>
+    struct TriDiagonal
+    {
+        u32 n = 0;
+        std::vector<T> lower;
+        std::vector<T> diag;
+        std::vector<T> upper;
+
+        TriDiagonal() = default;
+        TriDiagonal(u32 size)
+            : n(size), lower(size, T(0)), diag(size, T(0)), upper(size, T(0))
+        {}
+
+        void resize(u32 size)
+        {
+            n = size;
+            lower.assign(size, T(0));
+            diag.assign(size, T(0));
+            upper.assign(size, T(0));
+        }
+
+        // dense-style read access, only meant for debugging and tests
+        T operator()(u32 i, u32 j) const
+        {
+            if (i == j)     return diag[i];
+            if (j + 1 == i) return lower[i];
+            if (i + 1 == j) return upper[i];
+            return T(0);
+        }
+    };
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cmath>
+
+#include "vk/vk.h"
+#include "ludwig/mesh/structured-mesh.h"
+
+namespace ludwig::solve
+{
+    enum class TurbulenceModel : u8
+    {
+        Laminar = 0,
+        CebeciSmith, // two-layer algebraic eddy viscosity, van Driest damping and Klebanoff intermittency
+    };
+
+    struct EddyViscosity
+    {
+        TurbulenceModel model = TurbulenceModel::Laminar;
+        f64 x_transition = 0.0;     // laminar upstream, turbulent from here on
+        f64 kappa        = 0.40;    // von Karman constant
+        f64 A_plus       = 26.0;    // van Driest damping length in wall units
+        f64 alpha        = 0.0168;  // Clauser constant of the outer layer
+
+        bool active(f64 x) const { return model != TurbulenceModel::Laminar && x >= x_transition; }
+    };
+
+    // Cebeci-Smith effective viscosity nu + nu_t of one station into nu_eff (jmax):
+    //   inner  nu_t = ( kappa y ( 1 - exp(-y u_tau / (A+ nu)) ) )^2 |du/dy|
+    //   outer  nu_t = alpha Ue delta* / ( 1 + 5.5 (y / delta)^6 )
+    // with the inner value used from the wall up to the first node where it reaches the outer
+    // one. delta* and delta (u = 0.995 Ue) come from one reduction over the profile, the second
+    // pass evaluates the switch in place and writes nu_eff, nothing is allocated.
+    inline void eddy_viscosity(const f64* u, f64 Ue, f64 nu, const WallNormalMetrics& m, const EddyViscosity& model, f64* nu_eff)
+    {
+        const f64* w  = m.quadrature.data();
+        const f64* dy = m.dy.data();
+        const f64* d1 = m.d1.data();
+        const u32 jmax = (u32)m.quadrature.size();
+        const f64 r = 1.0 / Ue;
+
+        f64 delta1 = 0.0;
+        f64 delta  = 0.0;
+        f64 y = 0.0;
+        for (u32 j = 0; j < jmax; j++)
+        {
+            delta1 += w[j] * ( 1.0 - u[j] * r );
+            if (delta == 0.0 && u[j] >= 0.995 * Ue)
+                delta = y;
+            if (j < jmax-1)
+                y += dy[j];
+        }
+        if (delta == 0.0)
+            delta = y;
+
+        f64 dudy_wall = m.wall_gradient[0] * u[0] + m.wall_gradient[1] * u[1] + m.wall_gradient[2] * u[2];
+        f64 u_tau     = std::sqrt(nu * std::abs(dudy_wall));
+        f64 damping   = u_tau / ( model.A_plus * nu );
+        f64 outer     = model.alpha * std::abs(Ue) * delta1;
+        f64 inv_delta = 1.0 / delta;
+
+        nu_eff[0] = nu;
+        y = 0.0;
+        bool inner = true;
+        for (u32 j = 1; j < jmax; j++)
+        {
+            y += dy[j-1];
+            f64 q  = y * inv_delta;
+            f64 q2 = q * q;
+            f64 nu_o = outer / ( 1.0 + 5.5 * q2 * q2 * q2 );
+            if (inner && j < jmax-1)
+            {
+                f64 l    = model.kappa * y * ( 1.0 - std::exp(-y * damping) );
+                f64 nu_i = l * l * std::abs(u[j+1] - u[j-1]) * d1[j];
+                inner = nu_i < nu_o;
+                if (inner)
+                {
+                    nu_eff[j] = nu + nu_i;
+                    continue;
+                }
+            }
+            nu_eff[j] = nu + nu_o;
+        }
+    }
+}
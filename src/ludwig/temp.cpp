@@ -1,177 +1,181 @@
 #include "temp.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
-#include <chrono>
-#include <functional>
+#include <utility>
 
 
+#include "ludwig/core/profile.h"
+#include "ludwig/core/view.h"
 #include "ludwig/mesh/geometry.h"
 #include "ludwig/mesh/uniform-grid.h"
-#include "ludwig/solver/tdma.h"
+#include "ludwig/mesh/structured-mesh.h"
+#include "ludwig/solver/solvers.h"
 #include "ludwig/flow/flowfield.h"
+#include "ludwig/flow/case.h"
+#include "ludwig/flow/propeties.h"
+#include "ludwig/io/cgns.h"
 #ifdef DEBUG
     #include "tests/test-matrix.h"
     #include "tests/test-vector.h"
     #include "tests/test-arrays.h"
 #endif
+#ifdef LW_DEBUG
+    #include "tests/test-all.h"
+#endif
 
 #include "cgnslib.h"
 
 namespace ludwig
 {
 
-    void run()
+    void run(const char* profile_trace)
     {
         std::cout << "TEST\n";
-        f64 density = 1.182;
-        f64 viscosity = 1.83e-5;
-        f64 U0 = 1.0;
-
-
-        // geom --> move to a geometry structure
-        f64 plate_length = 0.2;
-        f64 xmin = 0.005*plate_length;
-        f64 xmax = 0.13*plate_length;
+        BoundaryLayerCase c;
+        // the thermal march is laminar, it has no eddy viscosity model yet
+        if (c.heated && c.turbulent)
+        {
+            std::cout << "heated turbulent cases are not supported: the energy equation is marched laminar only\n";
+            return;
+        }
+        if (profile_trace)
+            core::profile::enable();
+        f64 density = c.density;
+        f64 viscosity = c.viscosity;
 
-        f64 ymin = 0.0;
-        f64 ymax = 0.02*plate_length;
-        
         // geom  = { {xmin, ymin), (xmax, ymin), (xmax, ymax), (xmin, ymax) }
-        
         // grid -> move to a mesh structure ... how to handle boundary conditions? Generally or specific for this case?
-        // mesh = HexMesh(geom, inflation_rate, ni, nj, nk=1) 
-        uint32_t imax = 10;
-        uint32_t jmax = 100;
-        f64 deltax = ( xmax - xmin ) / ( imax - 1 );
-        f64 deltay = ( ymax - ymin ) / ( jmax - 1 );
-
-        // for now just assume uniform grid
-        Vector<f64> x = vk::linspace(xmin, xmax, imax);
-        Vector<f64> y = vk::linspace(ymin, ymax, jmax);     
-
-        std::vector<f64> dx(imax-1, deltax);
-        std::vector<f64> dy(jmax-1, deltay);
+        StructuredMesh mesh(c.mesh_spec());
+
+        u32 imax = mesh.imax;
+        u32 jmax = mesh.jmax;
+        const std::vector<f64>& x  = mesh.x;
+        const std::vector<f64>& y  = mesh.y;
         
         // flowfield(mesh)
         Matrix<f64> u(imax, jmax, 0.0);
         Matrix<f64> v(imax, jmax, 0.0);
         
         std::vector<f64> Ue(imax);
-        std::vector<f64> Re(imax);
-        std::vector<f64> del1(imax);
-
         for (u32 i = 0; i < imax; i++)
         {
-            Ue[i] = U0 * ( 1 - x[i]/plate_length );
-            Re[i] = Ue[i] * x[i] * density/viscosity;
-            del1[i] = 5.0 * x[i] / pow(Re[i], 0.5);
+            Ue[i] = c.edge_velocity(x[i]);
             u(i, jmax-1) = Ue[i];
         }
         
         // initial conditions
-        for (u32 j = 1; j < jmax-1; j++)
+        inflow_profile(c, y, x[0], x[1], &u(0, 0), &v(0, 0));
+
         {
-            if ( y[j] >= del1[0] )
-                u(0, j) = Ue[0];
-            else
-                u(0, j) = Ue[0] * pow((y[j] / del1[0]),0.5);
+            LW_PROFILE_ZONE("run/print-inflow");
+            for (u32 i = 0; i < imax; i++)
+            {
+                core::ArrayView<const f64> vi = core::station(std::as_const(v), i);
+                for (u32 j = 0; j < jmax; j++)
+                    std::cout << std::setw(10) << vi[j] << '\t';
+                std::cout << "\n";
+            }
         }
 
-        for (u32 j = 1; j < jmax; j++)
-             v(0, j) = v(0,j-1) - dy[j-1]*((u(0,j)/Ue[0])*(Ue[1] - Ue[0])/deltax - y[j]/del1[0]*(del1[1]-del1[0])/deltax*(u(0,j) - u(0,j-1) )/dy[j-1]);
+        // the output field and the solver work buffers, carved from one huge-page block
+        core::Arena arena(FlowFieldSoA::arena_bytes(imax, jmax) + solve::BoundaryLayerSolver::arena_bytes(jmax)
+                          + solve::ThermalBoundaryLayerSolver::arena_bytes(jmax), core::Pages::Huge);
 
-        for (u32 i = 0; i < imax; i++)
+        // Flowfield.solve( solverfn-> Crank_Nicolson)
+        solve::BoundaryLayerSolver solver(imax, jmax, &arena);
+        solve::StationIntegrals integrals;
+        solver.set_integrals(&integrals);
+        solver.set_turbulence(solve::case_turbulence(c));
+
+        // heated wall: energy equation with Sutherland viscosity and ideal-gas density instead
+        GasProperties gas;
+        Matrix<f64> T(imax, jmax, c.edge_temperature);
+        if (c.heated)
         {
+            LW_PROFILE_ZONE("run/march");
             for (u32 j = 0; j < jmax; j++)
-                std::cout << std::setw(10) << v(i,j) << '\t';
-            std::cout << "\n";
+                T(0, j) = c.wall_temperature + ( c.edge_temperature - c.wall_temperature ) * u(0, j) / Ue[0];
+            solve::ThermalBoundaryLayerSolver thermal(jmax, &arena);
+            thermal.set_properties(gas);
+            thermal.set_wall(solve::ThermalWall::Isothermal, c.wall_temperature);
+            thermal.set_integrals(&integrals);
+            thermal.solve(mesh, Ue, c.edge_temperature, u, v, T);
+        }
+        else
+        {
+            LW_PROFILE_ZONE("run/march");
+            solver.solve(mesh, Ue, viscosity / density, u, v);
         }
 
-        // Flowfield.solve( solverfn-> Crank_Nicolson)
-        for (uint32_t i = 0; i < imax-1; i++)
         {
-            Matrix<f64> A(jmax-2, jmax-2);
-            Vector<f64> b(jmax-2);
-            Vector<f64> c(jmax-2);
+            LW_PROFILE_ZONE("run/print-integrals");
+            std::cout << std::setw(14) << "x" << std::setw(14) << "delta*" << std::setw(14) << "theta" << std::setw(14) << "H" << std::setw(14) << "cf" << "\n";
+            for (u32 i = 0; i < integrals.size(); i++)
+                std::cout << std::setw(14) << integrals.x[i] << std::setw(14) << integrals.displacement_thickness[i]
+                          << std::setw(14) << integrals.momentum_thickness[i] << std::setw(14) << integrals.shape_factor[i]
+                          << std::setw(14) << integrals.skin_friction[i] << "\n";
+        }
 
-            u32 k = 0;
-            for (u32 j = 1; j < jmax-1; j++)
-            {
-                f64 alpha = ( viscosity / density ) / u(i,j) * ( deltax / (dy[j-1]*dy[j-1]) );
-                f64 beta  = v(i,j) / u(i,j) * deltax / ( dy[j] + dy[j-1]);
-
-                if ( j == 1)
-                {
-                    A(k,k)   = 1.0l + 2.0l * alpha;
-                    A(k,k+1) = -alpha;
-                    b(k)     =  alpha*u(i+1,j-1) + u(i,j) - beta * (u(i,j+1) - u(i,j-1)) + (Ue[i+1]*Ue[i+1] - Ue[i]*Ue[i]) / (2. * u(i,j) );
-                } else if (j == jmax-2) {
-                    A(k,k-1) = -alpha;
-                    A(k,k)   = 1.0l + 2.0l * alpha;
-                    b(k)     = alpha*u(i+1,j+1) + u(i,j) - beta * ( u(i,j+1) - u(i,j-1)) + (Ue[i+1]*Ue[i+1] - Ue[i]*Ue[i]) / (2. * u(i,j));
-                } else {
-                    A(k,k-1) = -alpha;
-                    A(k,k)   = 1.0l + 2.0l * alpha;
-                    A(k,k+1) = -alpha;
-                    b(k)     = u(i,j) - beta * ( u(i,j+1) - u(i,j-1) ) + (Ue[i+1]*Ue[i+1] - Ue[i]*Ue[i]) / (2. * u(i,j));
-                }
-                k++;
-            }
-             solve::TDMA<f64>(A, b, c);
-            
-            // TODO(chris): replace detlay with dy[index] and double check the appropriate index to be used
-            for (u32 j=0; j < jmax-2; j++)
+        // stations are contiguous rows of u and v, viewed in place and copied row to row
+        FlowFieldSoA field(imax, jmax, arena);
+        for (u32 i = 0; i < imax; i++)
+        {
+            core::StationView<const f64> s = core::station(x[i], std::as_const(u), std::as_const(v), i);
+            s.u.copy_to(field.velocity.x.row(i));
+            s.v.copy_to(field.velocity.y.row(i));
+            std::fill_n(field.position.x.row(i), jmax, x[i]);
+            std::copy(y.begin(), y.end(), field.position.y.row(i));
+            for (u32 j = 0; j < jmax; j++)
             {
-                u(i+1, j+1) = c(j);
-                v(i+1, j+1) = v(i+1, j) - deltay / (2.0l*deltax) * ( u(i+1, j+1) - u(i+1, j+1) + u(i+1, j) - u(i, j) );
+                field.density(i, j)   = c.heated ? gas.density(T(i,j)) : density;
+                field.viscosity(i, j) = c.heated ? gas.viscosity(T(i,j)) : viscosity;
             }
-
         }
 
-        // for (uint32_t i = 0; i < imax; i++)
-        // {
-        //     for (uint32_t j = 0; j < jmax; j++)
-        //         std::cout << std::setprecision(8) << u(i,j) << "\t";
-
-        //     std::cout << std::endl;
-        // }
+        {
+            LW_PROFILE_ZONE("run/cgns");
+            io::CgnsWriter writer;
+            writer.write(field, "ludwig-run.cgns");
+            if (!writer.flush())
+                std::cout << writer.last_error() << "\n";
+        }
 
-        for (u32 i = 0; i < imax; i++)
+        if (profile_trace)
         {
-            for (u32 j = 0; j < jmax; j++)
-                std::cout << std::setprecision(8) << u(i,j) << "\t";
-            std::cout << "\n";
+            core::profile::enable(false);
+            core::profile::print_summary(std::cout);
+            if (!core::profile::write_chrome_trace(profile_trace))
+                std::cout << "could not write the profile trace " << profile_trace << "\n";
         }
     }
 
 }
 
-template<typename T>
-auto timeit(size_t iterations, std::function<void()> func)
-{
-    auto start = std::chrono::high_resolution_clock::now();
-
-    for (size_t i = 0; i < iterations; i++)
-        func();
-    auto stop  = std::chrono::high_resolution_clock::now();
-    return std::chrono::duration_cast<T>(stop - start) / iterations;
-}
-
 int dep_main(int argc, char** argv)
 {
-    ludwig::VectorField f(4,2,3);
-    for (uint64_t i = 0; i < f.size; i++)
-        std::cout << f[i] << "\n"; 
-    return 0;
-    // auto dur = timeit<std::chrono::nanoseconds>(1, []() { ludwig::Matrix<ludwig::f64>  A(100000, 10000, 1.23455); ludwig::f64 B = A[1000]; });
-
 #ifdef DEBUG
     ludwig::test::test_matrix();
     ludwig::test::test_arrays();
     ludwig::test::test_vector();
 #endif
-    auto dur = timeit<std::chrono::microseconds>(100, []() { ludwig::run(); });
-    std::cout << dur << "\n";
+#ifdef LW_DEBUG
+    ludwig::test::test_all();
+#endif
+    // profiling is opt-in: --profile [trace.json] or LUDWIG_PROFILE=trace.json
+    const char* trace = std::getenv("LUDWIG_PROFILE");
+    for (int k = 1; k < argc; k++)
+    {
+        if (!std::strcmp(argv[k], "--profile"))
+            trace = k + 1 < argc ? argv[++k] : "ludwig-trace.json";
+    }
+    if (trace && !*trace)
+        trace = "ludwig-trace.json";
+
+    // timings live in the ludwig-bench target
+    ludwig::run(trace);
     return 0;
 }
 
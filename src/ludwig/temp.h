@@ -2,6 +2,7 @@
 namespace ludwig
 {
 
-   void run();
-
+   // profile_trace: record profile zones and write them to this Chrome trace file, nullptr for no profiling
+   void run(const char* profile_trace = nullptr);
 
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+#include "vk/vk.h"
+
+namespace ludwig
+{
+    // vk supplies the unsigned and floating point aliases and the containers, the signed
+    // integer aliases ludwig needs on top of them live here
+
+    // signed counterpart of u64, for element strides and offsets that may run backwards
+    using i64 = std::int64_t;
+}
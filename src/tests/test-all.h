@@ -0,0 +1,33 @@
+#pragma once
+
+#include "tests/test-tdma.h"
+#include "tests/test-solver.h"
+#include "tests/test-mesh.h"
+#include "tests/test-arena.h"
+#include "tests/test-io.h"
+#include "tests/test-sweep.h"
+#include "tests/test-optimization.h"
+#include "tests/test-expression.h"
+#include "tests/test-dense.h"
+#include "tests/test-view.h"
+#include "tests/test-profile.h"
+
+namespace ludwig::test
+{
+    // the solver, mesh, core and io self-tests, each line printed with its (expect ...) value
+    static void test_all()
+    {
+        test_tdma();
+        test_solver();
+        test_mesh();
+        test_arena();
+        test_io();
+        test_thread_pool();
+        test_sweep();
+        test_optimization();
+        test_expression();
+        test_dense();
+        test_view();
+        test_profile();
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ludwig/core/arena.h"
+#include "ludwig/core/alloc-tracker.h"
+#include "ludwig/flow/flowfield.h"
+#include "ludwig/solver/solvers.h"
+
+namespace ludwig::test
+{
+    static void test_arena_scratch()
+    {
+        std::cout << "================ Arena scratch =================\n"; 
+        core::Arena arena(1 << 20, core::Pages::Huge);
+        std::cout << " capacity = " << arena.capacity() << " (expect " << core::huge_page << ")\n";
+        std::cout << " block 2MB aligned: " << ( reinterpret_cast<u64>(arena.data()) % core::huge_page == 0 ) << " (expect 1)\n";
+
+        // without huge pages the block is only rounded to a cache line
+        core::Arena small(1000);
+        std::cout << " normal pages capacity = " << small.capacity() << " (expect 1024)\n";
+        small.reserve(100);
+        std::cout << " after re-reserve = " << small.capacity() << ", used " << small.used() << " (expect 128, 0)\n";
+
+        f64* persistent = arena.allocate_array<f64>(100);
+        u64 mark = arena.used();
+        {
+            core::ScratchScope scope(arena);
+            f64* tmp = arena.allocate_array<f64>(1000);
+            tmp[999] = 1.0;
+            std::cout << " scratch 64B aligned: " << ( reinterpret_cast<u64>(tmp) % 64 == 0 ) << " (expect 1)\n";
+        }
+        persistent[0] = 1.0;
+        std::cout << " used after scope = " << arena.used() << " (expect " << mark << ")\n";
+    }
+
+    static void test_arena_flowfield()
+    {
+        std::cout << "=============== Arena FlowFieldSoA ==============\n"; 
+        u32 imax = 100, jmax = 37;
+        core::Arena arena(FlowFieldSoA::arena_bytes(imax, jmax));
+
+        core::AllocationStats before = core::allocation_stats();
+        FlowFieldSoA f(imax, jmax, arena);
+        core::AllocationStats after = core::allocation_stats();
+
+        f.velocity(3, 5).x = 2.0;
+        f.velocity(3, 5) = Vec2(3.0, 4.0);
+        std::cout << " velocity(3,5) = " << f.velocity(3, 5).x << ", " << f.velocity(3, 5).y << " (expect 3, 4)\n";
+        std::cout << " station rows 64B aligned: " << ( reinterpret_cast<u64>(f.velocity.x.row(7)) % 64 == 0 ) << " (expect 1)\n";
+        std::cout << " arena used = " << arena.used() << " of " << FlowFieldSoA::arena_bytes(imax, jmax) << "\n";
+        if (core::allocation_tracking_enabled())
+            std::cout << " heap allocations for the field: " << after.count - before.count << " (expect 0)\n";
+    }
+
+    // the field and both solvers carved from one block march exactly like solvers on their own blocks
+    static void test_arena_solvers()
+    {
+        std::cout << "=============== Arena shared by solvers =========\n";
+        u32 imax = 20, jmax = 60;
+        u64 bytes = FlowFieldSoA::arena_bytes(imax, jmax) + solve::BoundaryLayerSolver::arena_bytes(jmax)
+                  + solve::ThermalBoundaryLayerSolver::arena_bytes(jmax);
+        core::Arena arena(bytes);
+        FlowFieldSoA field(imax, jmax, arena);
+        solve::BoundaryLayerSolver shared(imax, jmax, &arena);
+        solve::ThermalBoundaryLayerSolver thermal(jmax, &arena);
+        std::cout << " used " << arena.used() << " of " << arena.capacity() << ", fits: " << ( arena.used() <= bytes ) << " (expect 1)\n";
+
+        std::vector<f64> x(imax), y(jmax), Ue(imax, 1.0);
+        for (u32 i = 0; i < imax; i++)
+            x[i] = 0.001 + 0.02 * i / (imax - 1);
+        for (u32 j = 0; j < jmax; j++)
+            y[j] = 0.004 * j / (jmax - 1);
+        Matrix<f64> u0(imax, jmax, 0.0), v0(imax, jmax, 0.0);
+        for (u32 j = 1; j < jmax; j++)
+            u0(0, j) = std::min(1.0, std::sqrt(y[j] / 0.0015));
+        Matrix<f64> u1 = u0, v1 = v0;
+
+        f64 nu = 1.83e-5 / 1.182;
+        solve::BoundaryLayerSolver own(imax, jmax);
+        own.set_scheme(solve::MarchingScheme::Theta, 0.5);
+        shared.set_scheme(solve::MarchingScheme::Theta, 0.5);
+        own.solve(x, y, Ue, nu, u0, v0);
+        shared.solve(x, y, Ue, nu, u1, v1);
+        f64 diff = 0.0;
+        for (u32 j = 0; j < jmax; j++)
+            diff = std::max(diff, std::abs(u0(imax-1, j) - u1(imax-1, j)));
+        std::cout << " shared vs own block, max |du| = " << diff << " (expect 0)\n";
+    }
+
+    static void test_arena()
+    {
+        test_arena_scratch();
+        test_arena_flowfield();
+        test_arena_solvers();
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+
+#include "ludwig/core/thread-pool.h"
+#include "ludwig/solver/dense.h"
+
+namespace ludwig::test
+{
+    // non-symmetric, diagonally weighted so it is well conditioned, with pivoting still needed
+    static Matrix<f64> dense_test_matrix(u32 n)
+    {
+        Matrix<f64> A(n, n, 0.0);
+        u64 seed = 12345;
+        for (u32 i = 0; i < n; i++)
+            for (u32 j = 0; j < n; j++)
+            {
+                seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+                A(i, j) = (f64)( seed >> 11 ) / (f64)( 1ull << 53 ) - 0.5;
+            }
+        for (u32 i = 0; i < n; i++)
+            A(i, i) += ( i % 3 == 0 ) ? 0.0 : 0.25 * std::sqrt((f64)n);
+        return A;
+    }
+
+    static f64 residual(const Matrix<f64>& A, const std::vector<f64>& x, const std::vector<f64>& b)
+    {
+        f64 r = 0.0;
+        for (u32 i = 0; i < A.dim1; i++)
+        {
+            f64 s = -b[i];
+            for (u32 j = 0; j < A.dim2; j++)
+                s += A(i, j) * x[j];
+            r = std::max(r, std::abs(s));
+        }
+        return r;
+    }
+
+    static void test_dense_lu()
+    {
+        std::cout << "========= LUFactorization =======================\n";
+        f64 data[9] = { 2.0, 1.0, 1.0, 1.0, 0.0, 1.0, 0.0, 3.0, 1.0 };
+        Matrix<f64> A3(3, 3, data);
+        std::cout << " |A| of the 3x3 in test_matrix_determinant: " << solve::determinant(A3) << " (expect -4)\n";
+
+        f64 sing[9] = { 1.0, 2.0, 3.0, 2.0, 4.0, 6.0, 1.0, 0.0, 1.0 };
+        solve::LUFactorization<f64> S(Matrix<f64>(3, 3, sing));
+        std::cout << " singular 3x3: singular() " << S.singular() << " determinant " << S.determinant() << " (expect 1 0)\n";
+
+        // several panels and a partial one, serial and on a pool
+        const u32 n = 300;
+        Matrix<f64> A = dense_test_matrix(n);
+        solve::LUFactorization<f64> lu(A);
+        core::ThreadPool pool(4);
+        solve::LUFactorization<f64> lu_pool(A, &pool);
+
+        f64 diff = 0.0;
+        for (u64 k = 0; k < A.size; k++)
+            diff = std::max(diff, std::abs(lu.factors()[k] - lu_pool.factors()[k]));
+        std::cout << " n = " << n << ", factors on 4 threads vs serial: " << diff << " (expect 0)\n";
+
+        // one factorization, several right-hand sides
+        f64 worst = 0.0;
+        for (u32 r = 0; r < 3; r++)
+        {
+            std::vector<f64> b(n), x(n);
+            for (u32 i = 0; i < n; i++)
+                b[i] = std::sin(0.1 * i + r);
+            x = b;
+            lu.solve(x);
+            worst = std::max(worst, residual(A, x, b));
+        }
+        std::cout << " max residual of 3 solves: " << worst << " (expect < 1e-12)\n";
+
+        Matrix<f64> X = lu.inverse();
+        f64 err = 0.0;
+        for (u32 i = 0; i < n; i++)
+            for (u32 j = 0; j < n; j++)
+            {
+                f64 s = 0.0;
+                for (u32 k = 0; k < n; k++)
+                    s += A(i, k) * X(k, j);
+                err = std::max(err, std::abs(s - ( i == j ? 1.0 : 0.0 )));
+            }
+        std::cout << " |A inverse(A) - I|: " << err << " (expect < 1e-12)\n";
+    }
+
+    static void test_dense_cholesky()
+    {
+        std::cout << "========= CholeskyFactorization =================\n";
+        // M = B B^T + n I is symmetric positive definite
+        const u32 n = 200;
+        Matrix<f64> B = dense_test_matrix(n);
+        Matrix<f64> M(n, n, 0.0);
+        for (u32 i = 0; i < n; i++)
+            for (u32 j = 0; j < n; j++)
+            {
+                f64 s = i == j ? (f64)n : 0.0;
+                for (u32 k = 0; k < n; k++)
+                    s += B(i, k) * B(j, k);
+                M(i, j) = s;
+            }
+
+        core::ThreadPool pool(4);
+        solve::CholeskyFactorization<f64> ch(M, &pool);
+        std::vector<f64> b(n), x(n);
+        for (u32 i = 0; i < n; i++)
+            b[i] = std::cos(0.05 * i);
+        x = b;
+        ch.solve(x);
+        std::cout << " definite: " << ch.definite() << " (expect 1), residual: " << residual(M, x, b) << " (expect < 1e-9)\n";
+
+        // log of the determinants, both far beyond the f64 range otherwise
+        solve::LUFactorization<f64> lu(M);
+        f64 log_ch = 0.0, log_lu = 0.0;
+        for (u32 i = 0; i < n; i++)
+        {
+            log_ch += 2.0 * std::log(ch.factors()(i, i));
+            log_lu += std::log(std::abs(lu.factors()(i, i)));
+        }
+        std::cout << " log|M| Cholesky vs LU: " << std::abs(log_ch - log_lu) / log_lu << " relative (expect < 1e-12)\n";
+
+        M(n/2, n/2) = -1.0;
+        std::cout << " indefinite: factor() " << ch.factor(M) << " (expect 0)\n";
+    }
+
+    static void test_dense()
+    {
+        test_dense_lu();
+        test_dense_cholesky();
+    }
+}
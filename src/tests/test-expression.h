@@ -0,0 +1,54 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+
+#include "ludwig/core/expression.h"
+#include "ludwig/core/alloc-tracker.h"
+
+namespace ludwig::test
+{
+    static void test_expression()
+    {
+        std::cout << "================ expression templates ==========\n";
+        const u32 d1 = 7;
+        const u32 d2 = 13;
+        Matrix<f64> X(d1, d2), Y(d1, d2), R(d1, d2, 0.0);
+        for (u64 k = 0; k < X.size; k++)
+        {
+            X[k] = 0.5 + 0.01 * k;
+            Y[k] = 2.0 - 0.03 * k;
+        }
+        const f64 a = 1.5, b = -0.25, c = 3.0;
+
+        // eager reference through the vk operators
+        Matrix<f64> aX = X;
+        aX *= a;
+        Matrix<f64> bY = Y;
+        bY *= b;
+        Matrix<f64> eager = aX + bY + (-c);
+
+        core::AllocationStats before = core::allocation_stats();
+        core::assign(R, core::lazy(X) * a + b * core::lazy(Y) - c);
+        u64 allocations = core::allocation_stats().count - before.count;
+
+        f64 diff = 0.0;
+        for (u64 k = 0; k < R.size; k++)
+            diff = std::max(diff, std::abs(R[k] - eager[k]));
+        std::cout << " a*X + b*Y - c, max difference to eager: " << diff << " (expect 0), allocations: " << allocations << " (expect 0)\n";
+
+        // in place on the destination, mixed containers, division and negation
+        std::vector<f64> v(X.size, 1.0);
+        core::assign(v, -( core::lazy(v) + core::lazy(X) ) / core::lazy(Y));
+        diff = 0.0;
+        for (u64 k = 0; k < v.size(); k++)
+            diff = std::max(diff, std::abs(v[k] + ( 1.0 + X[k] ) / Y[k]));
+        std::cout << " v = -(v + X) / Y in place, max error: " << diff << " (expect 0)\n";
+
+        Vector<f64> w(5, 2.0);
+        core::add_assign(w, 0.5 * core::lazy(w));
+        std::cout << " w += 0.5 w: " << w[0] << " " << w[4] << " (expect 3 3)\n";
+    }
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <cmath>
+#include <cstdio>
+
+#include "ludwig/io/cgns.h"
+#include "ludwig/io/checkpoint.h"
+#include "ludwig/io/station-sink.h"
+#include "ludwig/solver/solvers.h"
+
+namespace ludwig::test
+{
+    // the solver thread should only pay for the snapshot copies, not for the disk writes
+    static void test_cgns_writer()
+    {
+        std::cout << "================ CgnsWriter ====================\n"; 
+        u32 imax = 400, jmax = 200, writes = 6;
+        FlowFieldSoA f(imax, jmax);
+        for (u32 i = 0; i < imax; i++)
+            for (u32 j = 0; j < jmax; j++)
+            {
+                f.position(i, j) = Vec2(1e-3 * i, 1e-5 * j);
+                f.velocity(i, j) = Vec2(1.0 - 1.0 / ( 1.0 + j ), 0.0);
+            }
+
+        std::filesystem::path dir = std::filesystem::temp_directory_path();
+        io::CgnsWriter writer;
+        auto start = std::chrono::steady_clock::now();
+        for (u32 k = 0; k < writes; k++)
+            writer.write(f, ( dir / ( "ludwig-test-" + std::to_string(k) + ".cgns" ) ).string());
+        auto queued = std::chrono::steady_clock::now();
+        bool ok = writer.flush();
+        auto done = std::chrono::steady_clock::now();
+
+        std::cout << " written = " << writer.written() << " (expect " << writes << "), ok = " << ok << " (expect 1) " << writer.last_error() << "\n";
+        std::cout << " solver thread [ms] = " << std::chrono::duration<f64, std::milli>(queued - start).count()
+                  << ", until on disk [ms] = " << std::chrono::duration<f64, std::milli>(done - start).count() << "\n";
+
+        for (u32 k = 0; k < writes; k++)
+            std::filesystem::remove(dir / ( "ludwig-test-" + std::to_string(k) + ".cgns" ));
+    }
+
+    static void test_checkpoint()
+    {
+        std::cout << "================ Checkpoint ====================\n"; 
+        MeshSpec spec;
+        spec.x1 = 0.1;
+        spec.y1 = 0.01;
+        spec.imax = 50;
+        spec.jmax = 37;
+        spec.clustering = Clustering::Tanh;
+        spec.stretching = 2.0;
+        StructuredMesh mesh(spec);
+
+        io::MarchingState state;
+        state.station = 17;
+        state.nu = 1.5e-5;
+        state.Ue.assign(mesh.imax, 1.0);
+        state.del1.assign(mesh.imax, 1e-3);
+
+        FlowFieldSoA f(mesh.imax, mesh.jmax);
+        for (u32 i = 0; i < mesh.imax; i++)
+            for (u32 j = 0; j < mesh.jmax; j++)
+            {
+                f.position(i, j) = Vec2(mesh.x[i], mesh.y[j]);
+                f.velocity(i, j) = Vec2(std::sin(0.1 * i + j), 1.0 / 3.0 * j);
+                f.pressure(i, j) = 1e5 + i;
+            }
+
+        std::string path = ( std::filesystem::temp_directory_path() / "ludwig-test.lwck" ).string();
+        io::CheckpointWriter writer;
+        bool written = writer.write(path, mesh, state, f);
+
+        io::MappedCheckpoint map;
+        bool opened = map.open(path);
+        std::cout << " written = " << written << ", mapped = " << opened << " (expect 1, 1)\n";
+        if (!opened)
+            return;
+
+        const io::CheckpointHeader& h = map.header();
+        std::cout << " imax = " << h.imax << ", jmax = " << h.jmax << ", station = " << h.station << " (expect 50, 37, 17)\n";
+        std::cout << " u(3,5) in place = " << map.row(h.VelocityX, 3)[5] << " (expect " << f.velocity(3, 5).x << ")\n";
+
+        StructuredMesh mesh2;
+        io::MarchingState state2;
+        FlowFieldSoA f2;
+        map.restore(mesh2, state2, f2);
+        bool same = mesh2.y == mesh.y && state2.Ue == state.Ue && f2.velocity.x.data == f.velocity.x.data
+                 && f2.velocity.y.data == f.velocity.y.data && f2.pressure.data == f.pressure.data;
+        std::cout << " restored bit for bit = " << same << " (expect 1)\n";
+        map.close();
+
+        // a header whose sections run past the end of the file is rejected before anything is read
+        auto corrupt = [&](auto edit)
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            io::CheckpointHeader bad;
+            file.read(reinterpret_cast<char*>(&bad), sizeof(bad));
+            edit(bad);
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&bad), sizeof(bad));
+            file.close();
+            bool ok = map.open(path);
+            map.close();
+            writer.write(path, mesh, state, f);
+            return ok;
+        };
+        bool long_rows    = corrupt([](io::CheckpointHeader& b) { b.imax *= 4; });
+        bool short_stride = corrupt([](io::CheckpointHeader& b) { b.stride = b.jmax - 1; });
+        bool past_end     = corrupt([](io::CheckpointHeader& b) { b.offsets[b.Viscosity] = b.bytes - 8; });
+        std::cout << " corrupt imax, stride, offset mapped = " << long_rows << ", " << short_stride << ", " << past_end << " (expect 0, 0, 0)\n";
+
+        std::filesystem::remove(path);
+    }
+
+    static void test_station_sinks()
+    {
+        std::cout << "================ Station sinks ==================\n"; 
+        u32 imax = 1000, jmax = 40;
+        std::vector<f64> y = wall_distribution(0.004, jmax, Clustering::Tanh, 2.0);
+        std::vector<f64> u(jmax), v(jmax, 0.0);
+        f64 nu = 1.5e-5;
+        f64 del = 5.0 * 0.001 / std::sqrt(0.001 / nu);
+        for (u32 j = 0; j < jmax; j++)
+            u[j] = y[j] >= del ? 1.0 : std::sqrt(y[j] / del);
+
+        std::filesystem::path dir = std::filesystem::temp_directory_path();
+        std::string path = ( dir / "ludwig-test-stream.bin" ).string();
+        io::BinaryStationSink binary(path, y, 64);
+        io::CgnsStationSink cgns(( dir / "ludwig-test-stream" ).string(), y, 300, 1.2, 1.8e-5);
+        io::ReducedStationSink reduced(y, imax);
+
+        solve::BoundaryLayerSolver solver(2, jmax);
+        solve::StationCallback all = [&](u32 i, f64 x, const f64* ui, const f64* vi) {
+            binary(i, x, ui, vi);
+            cgns(i, x, ui, vi);
+            reduced(i, x, ui, vi);
+        };
+        solver.solve_streaming(imax, [](u32 i) { return 0.001 + 2e-5 * i; }, [](f64) { return 1.0; }, nu, y, u, v, all);
+
+        bool closed = binary.close() && cgns.close();
+        u64 expected = sizeof(io::BinaryStationSink::Header) + jmax * sizeof(f64) + (u64)imax * ( 1 + 2 * jmax ) * sizeof(f64);
+        std::cout << " closed = " << closed << " (expect 1), stations = " << binary.stations() << " (expect " << imax << ")\n";
+        std::cout << " binary bytes = " << std::filesystem::file_size(path) << " (expect " << expected << ")\n";
+        std::cout << " cgns files = " << cgns.files() << " (expect 4)\n";
+
+        u32 i = imax - 1;
+        f64 cf = nu * reduced.dudy_wall[i] * std::sqrt(reduced.x[i] / nu);
+        std::cout << " reduced stations = " << reduced.x.size() << ", Cf/2 sqrt(Re_x) = " << cf << " (expect ~0.332)\n";
+
+        std::filesystem::remove(path);
+        for (u32 k = 0; k < cgns.files(); k++)
+        {
+            char name[40];
+            std::snprintf(name, sizeof(name), "ludwig-test-stream-%06u.cgns", k);
+            std::filesystem::remove(dir / name);
+        }
+    }
+
+    static void test_io()
+    {
+        test_cgns_writer();
+        test_checkpoint();
+        test_station_sinks();
+    }
+}
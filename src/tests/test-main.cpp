@@ -0,0 +1,8 @@
+#include "tests/test-all.h"
+
+// ludwig-tests: runs every self-test, compare each printed value with its (expect ...)
+int main()
+{
+    ludwig::test::test_all();
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <iomanip>
 #include "ludwig/types/types.h"
+#include "ludwig/solver/dense.h"
 
 namespace ludwig::test
 {
@@ -238,6 +239,23 @@ namespace ludwig::test
         print_matrix(A);
         f64 d = Determinant(A);
         std::cout << " |A| = " << d << std::endl;
+        std::cout << " |A| by LU = " << solve::determinant(A) << " (expect -4)" << std::endl;
+    }
+
+    static void test_matrix_inverse()
+    {
+        std::cout << "========= Matrix A^-1 ===========================\n"; 
+        f64 data[9] = {
+            2.0, 1.0, 1.0,
+            1.0, 0.0, 1.0, 
+            0.0, 3.0, 1.0
+        };
+        Matrix<f64> A(3,3,data);
+        Matrix<f64> Ainv = solve::inverse(A);
+        print_matrix(Ainv);
+        Matrix<f64> I = A * Ainv;
+        std::cout << " --- A A^-1 (expect I) --- \n";
+        print_matrix(I);
     }
 
     static void test_matrix()
@@ -246,6 +264,6 @@ namespace ludwig::test
         test_matrix_arithmatic();
         test_matrix_determinant();
         // test_matrix_submatrix();
-        // test_matrix_inverse();
+        test_matrix_inverse();
     }
 }
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+
+#include "ludwig/mesh/boundary.h"
+#include "ludwig/mesh/structured-mesh.h"
+#include "ludwig/solver/solvers.h"
+
+namespace ludwig::test
+{
+    static void test_mesh_distribution()
+    {
+        std::cout << "============ StructuredMesh distribution ============\n"; 
+        const char* names[] = { "uniform", "geometric", "tanh" };
+        Clustering kinds[] = { Clustering::Uniform, Clustering::Geometric, Clustering::Tanh };
+        f64 stretch[] = { 1.0, 1.15, 3.0 };
+        for (u32 k = 0; k < 3; k++)
+        {
+            std::vector<f64> y = wall_distribution(0.004, 40, kinds[k], stretch[k]);
+            std::cout << std::setw(10) << names[k] << ": y[0] = " << y.front() << ", y[n-1] = " << y.back()
+                      << " (expect 0.004), dy wall = " << y[1] - y[0] << ", dy edge = " << y[39] - y[38] << "\n";
+        }
+
+        // the non-uniform second derivative is exact for a quadratic, the central first
+        // derivative only first order where the spacing changes
+        MeshSpec spec;
+        spec.y1 = 1.0;
+        spec.jmax = 30;
+        spec.clustering = Clustering::Tanh;
+        spec.stretching = 2.5;
+        StructuredMesh mesh(spec);
+        const WallNormalMetrics& m = mesh.metrics;
+        f64 err2 = 0.0, err1 = 0.0;
+        for (u32 j = 1; j < mesh.jmax-1; j++)
+        {
+            const std::vector<f64>& y = mesh.y;
+            f64 fm = y[j-1]*y[j-1], f0 = y[j]*y[j], fp = y[j+1]*y[j+1];
+            f64 d2 = m.d2_lower[j] * (fm - f0) + m.d2_upper[j] * (fp - f0);
+            f64 d1 = m.d1[j] * (fp - fm);
+            err2 = std::max(err2, std::abs(d2 - 2.0));
+            err1 = std::max(err1, std::abs(d1 - 2.0 * y[j]));
+        }
+        std::cout << " max d2/dy2 error on y^2: " << err2 << " (expect ~0)\n";
+        std::cout << " max d/dy error on y^2:   " << err1 << " (expect small)\n";
+
+        f64 integral = 0.0;
+        for (u32 j = 0; j < mesh.jmax; j++)
+            integral += m.quadrature[j] * mesh.y[j] * mesh.y[j];
+        f64 gradient = m.wall_gradient[0] * 0.0 + m.wall_gradient[1] * ( mesh.y[1] + mesh.y[1]*mesh.y[1] )
+                     + m.wall_gradient[2] * ( mesh.y[2] + mesh.y[2]*mesh.y[2] );
+        std::cout << " quadrature of y^2 = " << integral << " (expect " << 1.0 / 3.0 << ")\n";
+        std::cout << " wall gradient of y + y^2 = " << gradient << " (expect 1)\n";
+    }
+
+    // Blasius skin friction on a uniform and a wall-clustered mesh of the same flat plate
+    static f64 flat_plate_cf(Clustering clustering, f64 stretching, u32 jmax)
+    {
+        f64 nu = 1.83e-5 / 1.182;
+        MeshSpec spec;
+        spec.x0 = 0.001;
+        spec.x1 = 0.021;
+        spec.y1 = 0.004;
+        spec.imax = 200;
+        spec.jmax = jmax;
+        spec.clustering = clustering;
+        spec.stretching = stretching;
+        StructuredMesh mesh(spec);
+
+        std::vector<f64> Ue(mesh.imax, 1.0);
+        Matrix<f64> u(mesh.imax, mesh.jmax, 0.0);
+        Matrix<f64> v(mesh.imax, mesh.jmax, 0.0);
+        f64 del = 5.0 * mesh.x[0] / std::sqrt(mesh.x[0] / nu);
+        for (u32 j = 1; j < mesh.jmax; j++)
+            u(0, j) = mesh.y[j] >= del ? 1.0 : std::sqrt(mesh.y[j] / del);
+
+        solve::BoundaryLayerSolver solver(mesh.imax, mesh.jmax);
+        solver.solve(mesh, Ue, nu, u, v);
+
+        // one-sided second order wall gradient on the first two cells
+        u32 i = mesh.imax - 1;
+        f64 h1 = mesh.metrics.dy[0], h2 = mesh.metrics.dy[1];
+        f64 dudy = ( u(i,1) * (h1+h2) * (h1+h2) - u(i,2) * h1 * h1 ) / ( h1 * h2 * (h1+h2) );
+        return nu * dudy * std::sqrt(mesh.x[i] / nu);
+    }
+
+    static void test_mesh_clustered_solve()
+    {
+        std::cout << "========= StructuredMesh clustered flat plate =========\n"; 
+        f64 uniform   = flat_plate_cf(Clustering::Uniform, 1.0, 200);
+        f64 clustered = flat_plate_cf(Clustering::Tanh, 3.0, 40);
+        std::cout << " uniform   jmax = 200, Cf/2 sqrt(Re_x) = " << uniform   << " (expect ~0.332)\n";
+        std::cout << " tanh      jmax =  40, Cf/2 sqrt(Re_x) = " << clustered << " (expect ~0.332)\n";
+    }
+
+    static void test_mesh_boundaries()
+    {
+        std::cout << "========= BoundaryNodes classification =========\n";
+        BoundaryNodes nodes(BoundarySpec(), 5);
+        std::cout << " wall " << nodes[BoundaryType::Wall].nodes[0] << ", inlet " << nodes[BoundaryType::Inlet].nodes[0]
+                  << ", outlet " << nodes[BoundaryType::Outlet].size() << ", total " << nodes.size() << " (expect 0, 4, 0, 2)\n";
+
+        BoundarySpec spec;
+        spec[Side::Edge] = BoundaryType::Symmetry;
+        BoundaryNodes station(spec, 5);
+        std::cout << " symmetric edge: wall " << station[BoundaryType::Wall].nodes[0] << ", symmetry " << station[BoundaryType::Symmetry].nodes[0]
+                  << " <- " << station[BoundaryType::Symmetry].neighbours[0] << ", total " << station.size() << " (expect 0, 4 <- 3, 2)\n";
+    }
+
+    static void test_mesh()
+    {
+        test_mesh_distribution();
+        test_mesh_clustered_solve();
+        test_mesh_boundaries();
+    }
+}
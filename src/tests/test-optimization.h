@@ -0,0 +1,127 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ludwig/optimization/dual.h"
+#include "ludwig/optimization/gradient_descent.h"
+#include "ludwig/optimization/recovery-design.h"
+#include "ludwig/solver/crank-nicolson.h"
+#include "ludwig/solver/marching.h"
+
+namespace ludwig::test
+{
+    static BoundaryLayerCase recovery_case()
+    {
+        BoundaryLayerCase c;
+        c.plate_length = 1.0;
+        c.x_start = 0.02;
+        c.x_end   = 0.1;
+        c.height  = 0.012;
+        c.imax = 80;
+        c.jmax = 80;
+        return c;
+    }
+
+    static void test_dual()
+    {
+        std::cout << "================ Dual ==========================\n";
+        using D = optimize::Dual<2>;
+        D x = D::variable(1.5, 0);
+        D y = D::variable(0.5, 1);
+        // f = x^2 y / (1 + sqrt(x)),  df/dx = 2xy / s - x^2 y / (2 sqrt(x) s^2),  df/dy = x^2 / s
+        D f = x * x * y / ( 1.0 + sqrt(x) );
+        f64 s  = 1.0 + std::sqrt(1.5);
+        f64 fx = 2.0 * 1.5 * 0.5 / s - 1.5 * 1.5 * 0.5 / ( 2.0 * std::sqrt(1.5) * s * s );
+        f64 fy = 1.5 * 1.5 / s;
+        std::cout << " d/dx error: " << std::abs(f.grad[0] - fx) << ", d/dy error: " << std::abs(f.grad[1] - fy) << " (expect < 1e-15)\n";
+    }
+
+    // the templated kernel on f64 against BoundaryLayerSolver's Implicit march
+    static void test_marching_kernel()
+    {
+        std::cout << "================ MarchingKernel<f64> ===========\n";
+        BoundaryLayerCase c = recovery_case();
+        StructuredMesh mesh(c.mesh_spec());
+        const u32 imax = mesh.imax;
+        const u32 jmax = mesh.jmax;
+
+        Matrix<f64> u(imax, jmax, 0.0);
+        Matrix<f64> v(imax, jmax, 0.0);
+        std::vector<f64> Ue(imax);
+        for (u32 i = 0; i < imax; i++)
+        {
+            Ue[i] = c.edge_velocity(mesh.x[i]);
+            u(i, jmax-1) = Ue[i];
+        }
+        inflow_profile(c, mesh.y, mesh.x[0], mesh.x[1], &u(0, 0), &v(0, 0));
+
+        std::vector<f64> u0(&u(0, 0), &u(0, 0) + jmax), v0(&v(0, 0), &v(0, 0) + jmax), u1(jmax), v1(jmax);
+        solve::BoundaryLayerSolver solver(imax, jmax);
+        solver.solve(mesh, Ue, c.nu(), u, v);
+
+        solve::MarchingKernel<f64> kernel(jmax);
+        f64 diff = 0.0;
+        for (u32 i = 1; i < imax; i++)
+        {
+            kernel.advance(mesh.metrics, mesh.x[i] - mesh.x[i-1], Ue[i-1], Ue[i], c.nu(), u0.data(), v0.data(), u1.data(), v1.data());
+            std::swap(u0, u1);
+            std::swap(v0, v1);
+            for (u32 j = 0; j < jmax; j++)
+                diff = std::max(diff, std::abs(u0[j] - u(i, j)) + std::abs(v0[j] - v(i, j)));
+        }
+        std::cout << " max difference to BoundaryLayerSolver: " << diff << " (expect < 1e-12)\n";
+    }
+
+    static void test_gradient()
+    {
+        std::cout << "================ forward-mode gradient =========\n";
+        BoundaryLayerCase c = recovery_case();
+        optimize::RecoveryDesign design(c, StructuredMesh(c.mesh_spec()));
+        design.drag = 0.5;
+        const std::array<f64, 3> p = { 0.06, 0.02, 1.1 };
+
+        optimize::Dual<3> J = optimize::evaluate_gradient<3>(design, p);
+        std::cout << " cost: " << design(p) << " dual value: " << J.value << " (expect equal)\n";
+        for (u32 k = 0; k < 3; k++)
+        {
+            // central differences as the reference, two marches per parameter
+            f64 h = 1e-6;
+            std::array<f64, 3> a = p, b = p;
+            a[k] += h;
+            b[k] -= h;
+            f64 fd = ( design(a) - design(b) ) / ( 2.0 * h );
+            std::cout << " dJ/dp" << k << " dual: " << std::setw(14) << J.grad[k] << " central: " << std::setw(14) << fd
+                      << " relative error: " << std::abs(J.grad[k] - fd) / std::abs(fd) << " (expect < 1e-6)\n";
+        }
+    }
+
+    static void test_gradient_descent()
+    {
+        std::cout << "================ gradient_descent ==============\n";
+        BoundaryLayerCase c = recovery_case();
+        optimize::RecoveryDesign design(c, StructuredMesh(c.mesh_spec()));
+        design.drag = 0.5;
+
+        optimize::GradientDescentSettings settings;
+        settings.max_iterations = 100;
+        optimize::OptimizationResult<3> r = optimize::gradient_descent<3>({ 0.0, 0.0, 1.0 }, design, settings);
+
+        // the recovery is pushed up to the separation margin: the smallest cf ends near cf_min
+        std::cout << " cost " << r.initial << " -> " << r.cost << " (expect lower) in " << r.iterations << " iterations, "
+                  << r.evaluations << " evaluations\n";
+        std::cout << " parameters: " << r.parameters[0] << " " << r.parameters[1] << " " << r.parameters[2]
+                  << ", exit Ue / U0: " << design.edge_velocity(r.parameters, design.mesh.x.back()) / c.U0 << " (expect < 1)\n";
+    }
+
+    static void test_optimization()
+    {
+        test_dual();
+        test_marching_kernel();
+        test_gradient();
+        test_gradient_descent();
+    }
+}
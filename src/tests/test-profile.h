@@ -0,0 +1,94 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <cstdio>
+#include <string>
+
+#include "ludwig/core/parallel.h"
+#include "ludwig/core/profile.h"
+#include "tests/test-solver.h"
+
+namespace ludwig::test
+{
+    static void test_profile_counters()
+    {
+        std::cout << "========= profile counters ======================\n";
+        core::profile::reset();
+        core::profile::enable();
+        MarchingCase c;
+        solve::BoundaryLayerSolver solver(c.imax, c.jmax);
+        solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+        core::profile::enable(false);
+
+        std::cout << " stations: " << core::profile::counter(core::profile::Counter::Stations) << " (expect " << c.imax - 1 << ")\n";
+        std::cout << " solves: " << core::profile::counter(core::profile::Counter::Solves) << " (expect " << solver.solves() << ")\n";
+
+        std::ostringstream summary;
+        core::profile::print_summary(summary);
+        std::cout << " summary lists march/station and march/tdma: "
+                  << ( summary.str().find("march/station") != std::string::npos && summary.str().find("march/tdma") != std::string::npos )
+                  << " (expect 1)\n";
+    }
+
+    static void test_profile_trace()
+    {
+        std::cout << "========= profile Chrome trace ==================\n";
+        const char* path = "ludwig-test-trace.json";
+        bool written = core::profile::write_chrome_trace(path);
+
+        std::ifstream in(path);
+        std::string head, text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        head = text.substr(0, 18);
+        std::cout << " written: " << written << ", starts with " << head << " (expect 1, {\"displayTimeUnit\")\n";
+        std::cout << " has complete events: " << ( text.find("\"ph\":\"X\"") != std::string::npos ) << " (expect 1)\n";
+        in.close();
+        std::remove(path);
+
+        // nothing is recorded while disabled
+        core::profile::reset();
+        MarchingCase c;
+        solve::BoundaryLayerSolver solver(c.imax, c.jmax);
+        solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+        std::cout << " stations while disabled: " << core::profile::counter(core::profile::Counter::Stations) << " (expect 0)\n";
+    }
+
+    static void test_profile_threads()
+    {
+        std::cout << "========= profile thread buffers ================\n";
+        core::profile::reset();
+        core::profile::enable();
+        // each call spawns 3 fresh threads, their buffers go back to the free list on exit
+        for (u32 call = 0; call < 8; call++)
+            core::parallel_for(4, 4, [](u32) { LW_PROFILE_ZONE("test/task"); });
+        core::profile::enable(false);
+
+        const char* path = "ludwig-test-trace.json";
+        core::profile::write_chrome_trace(path);
+        std::ifstream in(path);
+        std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        std::remove(path);
+
+        u32 tracks = 0;
+        for (u64 at = text.find("thread_name"); at != std::string::npos; at = text.find("thread_name", at + 1))
+            tracks++;
+        std::ostringstream summary;
+        core::profile::print_summary(summary);
+        std::cout << " thread tracks after 8 calls: " << ( tracks <= 4 ) << " (expect 1)\n";
+        std::cout << " test/task calls: " << ( summary.str().find("test/task") != std::string::npos ) << " (expect 1)\n";
+    }
+
+    static void test_profile()
+    {
+#ifdef LW_PROFILING
+        test_profile_counters();
+        test_profile_trace();
+        test_profile_threads();
+#else
+        std::cout << "========= profile: compiled out =================\n";
+#endif
+    }
+}
@@ -0,0 +1,428 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+
+#include "ludwig/solver/solvers.h"
+#include "ludwig/core/alloc-tracker.h"
+
+namespace ludwig::test
+{
+    // laminar flat plate with a 1/2-power inflow profile, small enough to print
+    struct MarchingCase
+    {
+        u32 imax = 20;
+        u32 jmax = 60;
+        f64 nu   = 1.83e-5 / 1.182;
+        std::vector<f64> x, y, Ue;
+        Matrix<f64> u, v;
+
+        MarchingCase(u32 ni = 20, u32 nj = 60) : imax(ni), jmax(nj)
+        {
+            x.resize(imax);
+            y.resize(jmax);
+            Ue.assign(imax, 1.0);
+            for (u32 i = 0; i < imax; i++)
+                x[i] = 0.001 + 0.02 * i / (imax - 1);
+            for (u32 j = 0; j < jmax; j++)
+                y[j] = 0.004 * j / (jmax - 1);
+            reset();
+        }
+
+        void reset()
+        {
+            u = Matrix<f64>(imax, jmax, 0.0);
+            v = Matrix<f64>(imax, jmax, 0.0);
+            f64 del = 5.0 * x[0] / std::sqrt(Ue[0] * x[0] / nu);
+            for (u32 j = 1; j < jmax; j++)
+                u(0, j) = y[j] >= del ? Ue[0] : Ue[0] * std::sqrt(y[j] / del);
+        }
+    };
+
+    static void test_solver_allocations()
+    {
+        std::cout << "========= BoundaryLayerSolver allocations =========\n"; 
+        if (!core::allocation_tracking_enabled())
+        {
+            std::cout << " allocation tracking disabled, build with LW_TRACK_ALLOCATIONS\n";
+            return;
+        }
+
+        const char* names[] = { "implicit", "theta", "newton" };
+        for (u32 k = 0; k < 3; k++)
+        {
+            MarchingCase c;
+            solve::BoundaryLayerSolver solver(c.imax, c.jmax);
+            solver.set_scheme(solve::MarchingScheme(k));
+
+            core::AllocationStats before = core::allocation_stats();
+            solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+            core::AllocationStats first = core::allocation_stats();
+
+            c.reset();
+            core::AllocationStats again = core::allocation_stats();
+            solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+            core::AllocationStats second = core::allocation_stats();
+
+            std::cout << " " << names[k] << ": allocations in first solve() " << first.count - before.count
+                      << ", second solve() " << second.count - again.count << " (expect 0, 0)\n";
+        }
+    }
+
+    static void test_solver_blasius()
+    {
+        std::cout << "========= BoundaryLayerSolver flat plate ==========\n"; 
+        MarchingCase c(200, 200);
+        solve::BoundaryLayerSolver solver(c.imax, c.jmax);
+        solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+
+        // Blasius: tau_w x / (rho U^2) * sqrt(Re_x) = 0.332
+        u32 i = c.imax - 1;
+        f64 dudy = c.u(i, 1) / c.y[1];
+        f64 cf   = c.nu * dudy * std::sqrt(c.x[i] / c.nu);
+        std::cout << " x = " << c.x[i] << ", Cf/2 sqrt(Re_x) = " << cf << " (expect ~0.332)\n";
+    }
+
+    // the streaming march keeps three stations and must reproduce the full-field march
+    static void test_solver_streaming()
+    {
+        std::cout << "========= BoundaryLayerSolver streaming ===========\n"; 
+        MarchingCase c;
+        solve::BoundaryLayerSolver solver(c.imax, c.jmax);
+        solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+
+        MarchingCase s;
+        std::vector<f64> u(s.jmax), v(s.jmax);
+        for (u32 j = 0; j < s.jmax; j++)
+        {
+            u[j] = s.u(0, j);
+            v[j] = s.v(0, j);
+        }
+
+        u32 stations = 0;
+        f64 diff = 0.0;
+        auto sink = [&](u32 i, f64, const f64* ui, const f64*) {
+            for (u32 j = 0; j < s.jmax; j++)
+                diff = std::max(diff, std::abs(ui[j] - c.u(i, j)));
+            stations++;
+        };
+        auto x  = [&](u32 i) { return s.x[i]; };
+        auto Ue = [](f64) { return 1.0; };
+        solve::StationPosition position = x;
+        solve::EdgeVelocity edge = Ue;
+        solve::StationCallback callback = sink;
+
+        core::AllocationStats before = core::allocation_stats();
+        solve::MarchingStats stats = solver.solve_streaming(s.imax, position, edge, s.nu, s.y, u, v, callback);
+        core::AllocationStats after = core::allocation_stats();
+
+        std::cout << " stations = " << stations << ", steps = " << stats.steps << " (expect " << s.imax << ", " << s.imax - 1 << ")\n";
+        std::cout << " max |u_stream - u_full| = " << diff << " (expect 0)\n";
+        if (core::allocation_tracking_enabled())
+            std::cout << " allocations while streaming: " << after.count - before.count << " (expect 0)\n";
+    }
+
+    // Blasius: delta* = 1.7208, theta = 0.664, H = 2.59, cf = 0.664 (all times sqrt(Re_x) / x)
+    static void test_solver_integrals()
+    {
+        std::cout << "========= BoundaryLayerSolver integrals ===========\n"; 
+        MarchingCase c(200, 200);
+        solve::BoundaryLayerSolver solver(c.imax, c.jmax);
+        solve::StationIntegrals integrals;
+        solver.set_integrals(&integrals);
+        solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+
+        u32 i = c.imax - 1;
+        f64 s = std::sqrt(c.x[i] / c.nu);
+        std::cout << " stations = " << integrals.size() << " (expect " << c.imax << ")\n";
+        std::cout << " delta* sqrt(Re_x)/x = " << integrals.displacement_thickness[i] * s / c.x[i] << " (expect ~1.721)\n";
+        std::cout << " theta  sqrt(Re_x)/x = " << integrals.momentum_thickness[i] * s / c.x[i] << " (expect ~0.664)\n";
+        std::cout << " H                   = " << integrals.shape_factor[i] << " (expect ~2.59)\n";
+        std::cout << " cf sqrt(Re_x)       = " << integrals.skin_friction[i] * s << " (expect ~0.664)\n";
+    }
+
+    // every spanwise column is the 2D march with its own edge velocity; with a constant Ue the
+    // crossflow obeys the momentum equation without pressure gradient, so w / We = u / Ue
+    static void test_solver_spanwise()
+    {
+        std::cout << "========= SpanwiseMarcher columns =================\n"; 
+        const u32 nz = 13;
+        MarchingCase c;
+        Matrix<f64> Ue(c.imax, nz, 1.0);
+        std::vector<f64> We(nz);
+        for (u32 k = 0; k < nz; k++)
+        {
+            We[k] = 0.2 + 0.3 * k / (nz - 1);
+            for (u32 i = 0; i < c.imax; i++)
+                Ue(i, k) = 1.0 - 0.05 * k / (nz - 1) * ( c.x[i] - c.x[0] ) / ( c.x[c.imax-1] - c.x[0] );
+        }
+
+        std::vector<f64> u((u64)c.jmax * nz), v((u64)c.jmax * nz), w((u64)c.jmax * nz);
+        for (u32 j = 0; j < c.jmax; j++)
+            for (u32 k = 0; k < nz; k++)
+            {
+                u[(u64)j * nz + k] = c.u(0, j);
+                w[(u64)j * nz + k] = We[k] * c.u(0, j);
+            }
+
+        solve::SpanwiseMarcher marcher(nz, c.jmax, 3);
+        marcher.set_mesh(c.y);
+        marcher.solve(c.x, Ue, We, c.nu, u, v, w);
+
+        solve::BoundaryLayerSolver solver(c.imax, c.jmax);
+        f64 du = 0.0, dv = 0.0, dw = 0.0;
+        for (u32 k = 0; k < nz; k++)
+        {
+            c.reset();
+            for (u32 i = 0; i < c.imax; i++)
+                c.Ue[i] = Ue(i, k);
+            solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+            for (u32 j = 0; j < c.jmax; j++)
+            {
+                du = std::max(du, std::abs(u[(u64)j * nz + k] - c.u(c.imax-1, j)));
+                dv = std::max(dv, std::abs(v[(u64)j * nz + k] - c.v(c.imax-1, j)));
+            }
+        }
+        for (u32 j = 0; j < c.jmax; j++)
+            dw = std::max(dw, std::abs(w[(u64)j * nz] - We[0] * u[(u64)j * nz]));
+
+        std::cout << " threads = " << marcher.threads() << ", columns = " << nz << "\n";
+        std::cout << " max |u - u_2d| = " << du << ", max |v - v_2d| = " << dv << " (expect ~0)\n";
+        std::cout << " max |w - We u / Ue| (Ue const) = " << dw << " (expect ~0)\n";
+    }
+
+    // turbulent flat plate at Re_L = 2e6 with Cebeci-Smith downstream of x = 0.02 L, against the
+    // Coles-Fernholz fit cf = 2 ( ln(Re_theta) / 0.384 + 4.127 )^-2 at the same Re_theta
+    static void test_solver_turbulent()
+    {
+        std::cout << "========= BoundaryLayerSolver turbulent ===========\n"; 
+        BoundaryLayerCase c;
+        c.U0           = 30.0;
+        c.deceleration = 0.0;
+        c.plate_length = 1.0;
+        c.x_start      = 0.002;
+        c.x_end        = 1.0;
+        c.height       = 0.04;
+        c.imax         = 1000;
+        c.jmax         = 200;
+        c.clustering   = Clustering::Tanh;
+        c.stretching   = 3.0;
+        c.turbulent    = true;
+
+        solve::BoundaryLayerSolver solver;
+        solve::CaseResult r = solve::run_case(c, solver, false);
+
+        f64 re_theta = c.U0 * r.exit.momentum_thickness / c.nu();
+        f64 fit = 2.0 / std::pow(std::log(re_theta) / 0.384 + 4.127, 2.0);
+        std::cout << " attached = " << r.attached << " / " << r.stations << " (expect all)\n";
+        std::cout << " Re_theta = " << re_theta << ", cf = " << r.exit.skin_friction << ", Coles-Fernholz = " << fit << " (expect within ~5%)\n";
+        std::cout << " H = " << r.exit.shape_factor << " (expect ~1.4)\n";
+    }
+
+    // the thermal march on a flat plate with edge velocity Ue from x = 0.001 to x_end, the
+    // inflow temperature blended from T_wall to Te with u / Ue (T_wall only seeds the inflow
+    // of the adiabatic wall)
+    struct ThermalCase
+    {
+        MarchingCase c;
+        Matrix<f64> T;
+        solve::ThermalBoundaryLayerSolver solver;
+        solve::StationIntegrals integrals;
+
+        ThermalCase(f64 Ue, f64 Te, f64 T_wall, solve::ThermalWall wall, bool dissipation, f64 x_end = 0.021, f64 height = 0.004)
+            : c(200, 200), solver(200)
+        {
+            const GasProperties& gas = solver.properties();
+            c.nu = gas.viscosity(Te) / gas.density(Te);
+            for (u32 i = 0; i < c.imax; i++)
+                c.x[i] = 0.001 + ( x_end - 0.001 ) * i / (c.imax - 1);
+            for (u32 j = 0; j < c.jmax; j++)
+                c.y[j] = height * j / (c.jmax - 1);
+            c.Ue.assign(c.imax, Ue);
+            c.reset();
+
+            T = Matrix<f64>(c.imax, c.jmax, Te);
+            for (u32 j = 0; j < c.jmax; j++)
+                T(0, j) = T_wall + ( Te - T_wall ) * c.u(0, j) / Ue;
+
+            solver.set_wall(wall, T_wall);
+            solver.set_dissipation(dissipation);
+            solver.set_integrals(&integrals);
+            solver.solve(StructuredMesh(c.x, c.y), c.Ue, Te, c.u, c.v, T);
+        }
+    };
+
+    static void test_solver_thermal()
+    {
+        std::cout << "========= ThermalBoundaryLayerSolver ==============\n"; 
+        const f64 Te = 298.15;
+
+        // without a temperature difference the momentum march is the constant property one
+        ThermalCase iso(1.0, Te, Te, solve::ThermalWall::Isothermal, false);
+        MarchingCase c(200, 200);
+        c.nu = iso.c.nu;
+        c.reset();
+        solve::BoundaryLayerSolver solver(c.imax, c.jmax);
+        solve::StationIntegrals laminar;
+        solver.set_integrals(&laminar);
+        solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+        f64 du = 0.0, dT = 0.0;
+        for (u32 j = 0; j < c.jmax; j++)
+        {
+            du = std::max(du, std::abs(iso.c.u(c.imax-1, j) - c.u(c.imax-1, j)));
+            dT = std::max(dT, std::abs(iso.T(c.imax-1, j) - Te));
+        }
+        std::cout << " T_wall = Te: max |u - u_laminar| = " << du << ", max |T - Te| = " << dT << " (expect ~0, 0)\n";
+        std::cout << " T_wall = Te: integrals " << iso.integrals.size() << " (expect " << c.imax << "), exit cf = " << iso.integrals.skin_friction.back()
+                  << " (expect ~" << laminar.skin_friction.back() << ")\n";
+
+        // heated wall, small difference: Nu_x / sqrt(Re_x) = 0.332 Pr^(1/3)
+        ThermalCase heated(1.0, Te, Te + 2.0, solve::ThermalWall::Isothermal, false);
+        u32 i = c.imax - 1;
+        const GasProperties& gas = heated.solver.properties();
+        f64 q  = heated.solver.wall_heat_flux(&heated.T(i, 0));
+        f64 k  = gas.conductivity(gas.viscosity(Te));
+        f64 nu = q * c.x[i] / ( k * 2.0 ) / std::sqrt(c.x[i] / heated.c.nu);
+        std::cout << " heated wall: Nu_x / sqrt(Re_x) = " << nu << " (expect ~" << 0.332 * std::cbrt(gas.gas.Pr) << ")\n";
+
+        // adiabatic wall with viscous heating: recovery factor sqrt(Pr)
+        const f64 Ue = 100.0;
+        const f64 T_seed = Te + 0.8 * 0.5 * Ue * Ue / gas.gas.cp;
+        ThermalCase adiabatic(Ue, Te, T_seed, solve::ThermalWall::Adiabatic, true, 0.2, 0.003);
+        f64 recovery = ( adiabatic.T(i, 0) - Te ) / ( 0.5 * Ue * Ue / gas.gas.cp );
+        std::cout << " adiabatic wall: recovery factor = " << recovery << " (expect ~" << std::sqrt(gas.gas.Pr) << ")\n";
+    }
+
+    // retarded flow Ue = 1 - 0.8 x from a developed profile at x = 0.02 to x = 0.1, so that the
+    // step error of the scheme is not swamped by the start-up from the square-root inflow
+    struct RetardedCase
+    {
+        std::vector<f64> u0, v0;
+
+        RetardedCase()
+        {
+            MarchingCase c(2000, 200);
+            march(c, 0.001, 0.02);
+            solve::BoundaryLayerSolver solver(c.imax, c.jmax);
+            solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+            for (u32 j = 0; j < c.jmax; j++)
+            {
+                u0.push_back(c.u(c.imax-1, j));
+                v0.push_back(c.v(c.imax-1, j));
+            }
+        }
+
+        static void march(MarchingCase& c, f64 x0, f64 x1)
+        {
+            for (u32 i = 0; i < c.imax; i++)
+            {
+                c.x[i]  = x0 + ( x1 - x0 ) * i / (c.imax - 1);
+                c.Ue[i] = 1.0 - 0.8 * c.x[i];
+            }
+            for (u32 j = 0; j < c.jmax; j++)
+                c.y[j] = 0.012 * j / (c.jmax - 1);
+            c.reset();
+        }
+
+        // wall shear at x = 0.1 and the number of tridiagonal solves it took
+        f64 wall_shear(u32 imax, solve::MarchingScheme scheme, f64 theta, const solve::NonlinearIteration& iteration, u64& solves) const
+        {
+            MarchingCase c(imax, 200);
+            march(c, 0.02, 0.1);
+            for (u32 j = 0; j < c.jmax; j++)
+            {
+                c.u(0, j) = u0[j];
+                c.v(0, j) = v0[j];
+            }
+            solve::BoundaryLayerSolver solver(c.imax, c.jmax);
+            solver.set_scheme(scheme, theta);
+            solver.set_iteration(iteration);
+            solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+            solves = solver.solves();
+            return c.nu * c.u(imax-1, 1) / c.y[1];
+        }
+    };
+
+    // the Newton scheme at theta = 0.5 is second order, the lagged Implicit scheme first order
+    static void test_solver_newton()
+    {
+        std::cout << "========= BoundaryLayerSolver Newton ==============\n"; 
+        RetardedCase r;
+        u64 solves = 0;
+        const solve::NonlinearIteration converged = { 10, 1e-10 };
+        f64 reference = r.wall_shear(4001, solve::MarchingScheme::Newton, 0.5, converged, solves);
+
+        f64 newton_error[3], implicit_error[3];
+        u64 newton_solves = 0;
+        u32 stations[3] = { 17, 33, 65 };
+        for (u32 k = 0; k < 3; k++)
+        {
+            newton_error[k]   = std::abs(r.wall_shear(stations[k], solve::MarchingScheme::Newton, 0.5, converged, newton_solves) / reference - 1.0);
+            implicit_error[k] = std::abs(r.wall_shear(stations[k], solve::MarchingScheme::Implicit, 1.0, {}, solves) / reference - 1.0);
+        }
+        std::cout << " error ratio per halving of dx: Newton " << newton_error[0] / newton_error[1] << ", " << newton_error[1] / newton_error[2]
+                  << " (expect ~4), Implicit " << implicit_error[0] / implicit_error[1] << ", " << implicit_error[1] / implicit_error[2] << " (expect ~2)\n";
+
+        // the same accuracy from the lagged scheme takes ~20x the stations
+        f64 lagged = std::abs(r.wall_shear(1200, solve::MarchingScheme::Implicit, 1.0, {}, solves) / reference - 1.0);
+        std::cout << " Newton 65 stations: error " << newton_error[2] << " in " << newton_solves << " solves, Implicit 1200 stations: error "
+                  << lagged << " in " << solves << " solves\n";
+
+        // early exit: passes per station well below the cap once converged
+        f64 per_station = (f64)newton_solves / 64;
+        std::cout << " solves per station = " << per_station << " (expect < " << converged.max_iterations + 1 << ")\n";
+    }
+
+    // the wall and edge follow BoundarySpec: a zero gradient edge outside the layer barely moves
+    // the wall shear, free slip on both sides keeps a uniform stream uniform
+    static void test_solver_boundaries()
+    {
+        std::cout << "========= BoundaryLayerSolver boundary types ======\n";
+        MarchingCase a, b;
+        solve::BoundaryLayerSolver solver(a.imax, a.jmax);
+        solver.solve(a.x, a.y, a.Ue, a.nu, a.u, a.v);
+
+        BoundarySpec spec;
+        spec[Side::Edge] = BoundaryType::Outlet;
+        solver.set_boundaries(spec);
+        solver.solve(b.x, b.y, b.Ue, b.nu, b.u, b.v);
+        u32 i = a.imax - 1, J = a.jmax - 1;
+        f64 shear = std::abs(b.u(i, 1) / a.u(i, 1) - 1.0);
+        std::cout << " zero gradient edge: u(J) - u(J-1) = " << b.u(i, J) - b.u(i, J-1) << ", wall shear change " << shear
+                  << " (expect 0, ~0)\n";
+
+        spec[Side::Wall] = BoundaryType::Symmetry;
+        solver.set_boundaries(spec);
+        for (solve::MarchingScheme scheme : { solve::MarchingScheme::Implicit, solve::MarchingScheme::Theta, solve::MarchingScheme::Newton })
+        {
+            MarchingCase c;
+            for (u32 j = 0; j < c.jmax; j++)
+                c.u(0, j) = 1.0;
+            solver.set_scheme(scheme, 0.5);
+            solver.solve(c.x, c.y, c.Ue, c.nu, c.u, c.v);
+            f64 du = 0.0, dv = 0.0;
+            for (u32 n = 0; n < c.imax; n++)
+                for (u32 j = 0; j < c.jmax; j++)
+                {
+                    du = std::max(du, std::abs(c.u(n, j) - 1.0));
+                    dv = std::max(dv, std::abs(c.v(n, j)));
+                }
+            std::cout << " free slip, scheme " << (u32)scheme << ": max |u - Ue| = " << du << ", max |v| = " << dv << " (expect ~0, ~0)\n";
+        }
+    }
+
+    static void test_solver()
+    {
+        test_solver_allocations();
+        test_solver_blasius();
+        test_solver_streaming();
+        test_solver_integrals();
+        test_solver_spanwise();
+        test_solver_turbulent();
+        test_solver_thermal();
+        test_solver_newton();
+        test_solver_boundaries();
+    }
+}
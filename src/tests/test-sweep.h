@@ -0,0 +1,75 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <vector>
+
+#include "ludwig/core/thread-pool.h"
+#include "ludwig/solver/sweep.h"
+
+namespace ludwig::test
+{
+    static void test_thread_pool()
+    {
+        std::cout << "================ ThreadPool ====================\n"; 
+        core::ThreadPool pool(4);
+        std::vector<std::atomic<u32>> hits(10007);
+        std::atomic<u32> bad_worker = 0;
+
+        // uneven costs so that workers run dry and steal
+        for (u32 round = 0; round < 3; round++)
+        {
+            pool.for_each((u32)hits.size(), [&](u32 k, u32 worker) {
+                if (worker >= pool.size())
+                    bad_worker++;
+                volatile f64 work = 0.0;
+                for (u32 n = 0; n < ( k < 1000 ? 20000u : 10u ); n++)
+                    work = work + n;
+                hits[k]++;
+            });
+        }
+
+        u32 wrong = 0;
+        for (std::atomic<u32>& h : hits)
+            wrong += h != 3;
+        std::cout << " indices not run exactly once per round: " << wrong << " (expect 0), bad worker ids: " << bad_worker << " (expect 0)\n";
+    }
+
+    static void test_sweep()
+    {
+        std::cout << "================ SweepRunner ===================\n"; 
+        std::vector<BoundaryLayerCase> cases;
+        for (f64 U0 : { 0.5, 1.0, 2.0, 4.0 })
+            for (f64 decel : { 0.0, 0.5, 1.0 })
+            {
+                BoundaryLayerCase c;
+                c.U0 = U0;
+                c.deceleration = decel;
+                c.imax = 400;
+                c.jmax = 120;
+                c.clustering = Clustering::Tanh;
+                c.stretching = 2.0;
+                cases.push_back(c);
+            }
+
+        solve::SweepRunner runner(4);
+        std::vector<solve::CaseResult> results = runner.run(cases);
+
+        solve::BoundaryLayerSolver serial;
+        u32 mismatch = 0;
+        for (u32 k = 0; k < cases.size(); k++)
+        {
+            solve::CaseResult r = solve::run_case(cases[k], serial);
+            mismatch += r.exit.skin_friction != results[k].exit.skin_friction || r.attached != results[k].attached;
+        }
+        std::cout << " cases = " << results.size() << ", results differing from a serial run: " << mismatch << " (expect 0)\n";
+
+        std::cout << std::setw(8) << "U0" << std::setw(8) << "decel" << std::setw(12) << "x exit" << std::setw(12) << "separation"
+                  << std::setw(8) << "H" << std::setw(14) << "cf" << "\n";
+        for (u32 k = 0; k < cases.size(); k++)
+            std::cout << std::setw(8) << cases[k].U0 << std::setw(8) << cases[k].deceleration << std::setw(12) << results[k].x_exit
+                      << std::setw(12) << results[k].separation_x << std::setw(8) << results[k].exit.shape_factor
+                      << std::setw(14) << results[k].exit.skin_friction << "\n";
+    }
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "ludwig/solver/tdma.h"
+#include "ludwig/solver/tdma-batched.h"
+#include "ludwig/solver/tdma-parallel.h"
+
+namespace ludwig::test
+{
+    // diagonally dominant system with a known solution x(k) = k + 1
+    static void make_tridiagonal_system(u32 n, TriDiagonal<f64>& A, std::vector<f64>& d)
+    {
+        A.resize(n);
+        d.assign(n, 0.0);
+        for (u32 k = 0; k < n; k++)
+        {
+            A.lower[k] = (k > 0)   ? -1.0 - 0.01 * k : 0.0;
+            A.upper[k] = (k < n-1) ? -1.0 + 0.01 * k : 0.0;
+            A.diag[k]  = 4.0;
+        }
+        for (u32 k = 0; k < n; k++)
+        {
+            d[k] = A.diag[k] * (k + 1);
+            if (k > 0)   d[k] += A.lower[k] * k;
+            if (k < n-1) d[k] += A.upper[k] * (k + 2);
+        }
+    }
+
+    static void test_tdma_banded()
+    {
+        std::cout << "========= TDMA(TriDiagonal, d, scratch) ============\n"; 
+        const u32 n = 8;
+        TriDiagonal<f64> A;
+        std::vector<f64> d;
+        make_tridiagonal_system(n, A, d);
+
+        // reference: dense storage through the original TDMA
+        Matrix<f64> M(n, n, 0.0);
+        Vector<f64> b(n);
+        Vector<f64> x(n);
+        for (u32 i = 0; i < n; i++)
+        {
+            for (u32 j = 0; j < n; j++)
+                M(i,j) = A(i,j);
+            b(i) = d[i];
+        }
+        solve::TDMA<f64>(M, b, x);
+
+        std::vector<f64> scratch(n);
+        solve::TDMA<f64>(A, d, scratch);
+
+        f64 err = 0.0;
+        for (u32 k = 0; k < n; k++)
+        {
+            std::cout << std::setw(4) << k << std::setw(12) << x(k) << std::setw(12) << d[k] << "\n";
+            err = std::max(err, std::abs(d[k] - x(k)));
+            err = std::max(err, std::abs(d[k] - (k + 1)));
+        }
+        std::cout << " max |error| = " << err << " (expect ~1e-15)\n";
+    }
+
+    static void test_tdma_batched()
+    {
+        std::cout << "========= TDMA(BatchedTriDiagonal, d, scratch) =====\n"; 
+        const u32 n = 16;
+        const u32 N = 11; // not a multiple of the simd width, exercises the scalar tail
+        BatchedTriDiagonal<f64> B(n, N);
+        std::vector<f64> bd((u64)n * N);
+
+        TriDiagonal<f64> A;
+        std::vector<f64> d;
+        make_tridiagonal_system(n, A, d);
+        for (u32 s = 0; s < N; s++)
+        {
+            for (u32 k = 0; k < n; k++)
+            {
+                B.lower[B.index(k, s)] = A.lower[k];
+                B.diag[B.index(k, s)]  = A.diag[k] + s;
+                B.upper[B.index(k, s)] = A.upper[k];
+                bd[B.index(k, s)]      = d[k] + s * (k + 1);
+            }
+        }
+
+        std::vector<f64> scratch((u64)n * N);
+        solve::TDMA<f64>(B, bd, scratch);
+
+        f64 err = 0.0;
+        for (u32 s = 0; s < N; s++)
+            for (u32 k = 0; k < n; k++)
+                err = std::max(err, std::abs(bd[B.index(k, s)] - (k + 1)));
+        std::cout << " systems: " << N << ", max |error| = " << err << " (expect ~1e-15)\n";
+    }
+
+    static void test_tdma_partitioned()
+    {
+        std::cout << "========= TDMA_partitioned(A, d, ws, blocks) =======\n"; 
+        const u32 n = 10001;
+        TriDiagonal<f64> A;
+        std::vector<f64> d;
+        make_tridiagonal_system(n, A, d);
+
+        solve::TridiagonalWorkspace<f64> ws;
+        ws.threads = 4;
+        for (u32 blocks : {1u, 2u, 3u, 7u, 64u})
+        {
+            std::vector<f64> x = d;
+            solve::TDMA_partitioned(A, x, ws, blocks);
+
+            f64 err = 0.0;
+            for (u32 k = 0; k < n; k++)
+                err = std::max(err, std::abs(x[k] - (k + 1)) / (k + 1));
+            std::cout << " blocks: " << std::setw(3) << blocks << ", max relative error = " << err << " (expect ~1e-15)\n";
+        }
+
+        ws.parallel_threshold = 1000;
+        ws.min_block_rows     = 1000;
+        std::vector<f64> x = d;
+        solve::tridiagonal_solve(A, x, ws);
+        f64 err = 0.0;
+        for (u32 k = 0; k < n; k++)
+            err = std::max(err, std::abs(x[k] - (k + 1)) / (k + 1));
+        std::cout << " tridiagonal_solve (Auto), max relative error = " << err << " (expect ~1e-15)\n";
+    }
+
+    static void test_tdma()
+    {
+        test_tdma_banded();
+        test_tdma_batched();
+        test_tdma_partitioned();
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+
+#include "ludwig/core/alloc-tracker.h"
+#include "ludwig/core/view.h"
+#include "ludwig/io/station-sink.h"
+#include "ludwig/solver/tdma.h"
+
+namespace ludwig::test
+{
+    static void test_view_slicing()
+    {
+        std::cout << "========= BlockView slices ======================\n";
+        Array3<f64> A(4, 3, 2);
+        for (u32 k = 0; k < 2; k++)
+            for (u32 j = 0; j < 3; j++)
+                for (u32 i = 0; i < 4; i++)
+                    A(i, j, k) = i + 10 * j + 100 * k;
+
+        core::AllocationStats before = core::allocation_stats();
+        core::BlockView<f64> V = core::view(A);
+        core::BlockView<f64> B = V.slice(1, 3, 0, 3, 1, 2);
+        core::ArrayView<f64> line = B.line_j(1);
+        u64 allocations = core::allocation_stats().count - before.count;
+
+        u32 wrong = 0;
+        for (u32 j = 0; j < B.nj; j++)
+            for (u32 i = 0; i < B.ni; i++)
+                wrong += B(i, j) != A(i + 1, j, 1);
+        std::cout << " slice (1..3, 0..3, 1): " << B.ni << " x " << B.nj << " x " << B.nk << ", wrong entries: " << wrong
+                  << " (expect 2 x 3 x 1, 0), allocations: " << allocations << " (expect 0)\n";
+        std::cout << " line_j(1) of the slice: " << line[0] << " " << line[1] << " " << line[2] << ", stride " << line.stride
+                  << " (expect 102 112 122, stride 4)\n";
+
+        // writes through a view land in the array
+        line.fill(-1.0);
+        std::cout << " after fill: A(2,1,1) = " << A(2, 1, 1) << " (expect -1)\n";
+
+        Matrix<f64> M(3, 5);
+        for (u32 i = 0; i < 3; i++)
+            for (u32 j = 0; j < 5; j++)
+                M(i, j) = i * 5 + j;
+        core::ArrayView<f64> row = core::station(M, 1);
+        core::ArrayView<f64> col = core::view(M).line_i(2);
+        std::cout << " Matrix station 1 contiguous: " << row.contiguous() << ", column 2: " << col[0] << " " << col[1] << " " << col[2]
+                  << " (expect 1, 2 7 12)\n";
+    }
+
+    static void test_view_tdma()
+    {
+        std::cout << "========= TDMA(TriDiagonal, ArrayView, scratch) =\n";
+        const u32 n = 50;
+        TriDiagonal<f64> A(n);
+        for (u32 k = 0; k < n; k++)
+        {
+            A.lower[k] = k > 0 ? -1.0 : 0.0;
+            A.upper[k] = k < n-1 ? -1.0 : 0.0;
+            A.diag[k]  = 2.5 + 0.01 * k;
+        }
+        std::vector<f64> d(n), scratch(n);
+        for (u32 k = 0; k < n; k++)
+            d[k] = std::sin(0.3 * k);
+
+        // the same right hand side as a strided line through an Array3 and as a Matrix row
+        Array3<f64> F(7, n, 2);
+        Matrix<f64> M(3, n, 0.0);
+        for (u32 k = 0; k < n; k++)
+        {
+            F(3, k, 1) = d[k];
+            M(2, k) = d[k];
+        }
+        solve::TDMA(A, d, scratch);
+        solve::TDMA(A, core::station(F, 3, 1), scratch);
+        solve::TDMA(A, core::station(M, 2), scratch);
+
+        f64 strided = 0.0, contiguous = 0.0;
+        for (u32 k = 0; k < n; k++)
+        {
+            strided    = std::max(strided, std::abs(F(3, k, 1) - d[k]));
+            contiguous = std::max(contiguous, std::abs(M(2, k) - d[k]));
+        }
+        std::cout << " strided (stride 7) vs vector: " << strided << ", contiguous Matrix row vs vector: " << contiguous << " (expect 0 0)\n";
+    }
+
+    static void test_view_sink()
+    {
+        std::cout << "========= station sinks from views ==============\n";
+        const u32 jmax = 12;
+        std::vector<f64> y(jmax);
+        for (u32 j = 0; j < jmax; j++)
+            y[j] = 0.001 * j * j;
+
+        // station i of u, v stored as a Matrix and, transposed, as an Array3 line of stride 5
+        Matrix<f64> u(5, jmax), v(5, jmax);
+        Array3<f64> ut(5, jmax, 1), vt(5, jmax, 1);
+        for (u32 i = 0; i < 5; i++)
+            for (u32 j = 0; j < jmax; j++)
+            {
+                u(i, j) = ut(i, j, 0) = std::tanh(j * ( 1.0 + 0.1 * i ) / 4.0);
+                v(i, j) = vt(i, j, 0) = 1e-3 * j * i;
+            }
+
+        io::ReducedStationSink pointers(y), views(y), strided(y);
+        for (u32 i = 0; i < 5; i++)
+        {
+            f64 x = 0.1 * i;
+            pointers(i, x, &u(i, 0), &v(i, 0));
+            views(i, core::station(x, u, v, i));
+            strided(i, core::StationView<const f64>{ x, core::station(ut, i), core::station(vt, i) });
+        }
+        f64 diff = 0.0;
+        for (u32 i = 0; i < 5; i++)
+            diff = std::max({ diff, std::abs(pointers.dudy_wall[i] - views.dudy_wall[i]), std::abs(pointers.dudy_wall[i] - strided.dudy_wall[i]),
+                              std::abs(pointers.Ue[i] - strided.Ue[i]) });
+        std::cout << " ReducedStationSink, pointers vs Matrix views vs strided views: " << diff << " (expect 0)\n";
+    }
+
+    static void test_view()
+    {
+        test_view_slicing();
+        test_view_tdma();
+        test_view_sink();
+    }
+}